@@ -29,6 +29,12 @@
 #include "gstd_session.h"
 #include "gstd_ipc.h"
 #include "gstd_tcp.h"
+#include "gstd_unix.h"
+#include "gstd_json_builder.h"
+#include "gstd_json_writer.h"
+#ifdef GSTD_ENABLE_SHM
+#include "gstd_shm.h"
+#endif
 
 #define GSTD_CLIENT_DEFAULT_PORT 5000
 
@@ -53,6 +59,7 @@ main (gint argc, gchar * argv[])
   GstdSession *session;
   guint i;
   gboolean version;
+  gchar *formatter = NULL;
   GError *error = NULL;
   GOptionContext *context;
   GOptionGroup *gstreamer_group;
@@ -63,6 +70,10 @@ main (gint argc, gchar * argv[])
    */
   GType supported_ipcs[] = {
     GSTD_TYPE_TCP,
+    GSTD_TYPE_UNIX,
+#ifdef GSTD_ENABLE_SHM
+    GSTD_TYPE_SHM,
+#endif
   };
 
   guint num_ipcs = (sizeof (supported_ipcs) / sizeof (GType));
@@ -73,6 +84,10 @@ main (gint argc, gchar * argv[])
     {"version", 'v', 0, G_OPTION_ARG_NONE, &version,
         "Print current gstd version", NULL}
     ,
+    {"formatter", 0, 0, G_OPTION_ARG_STRING, &formatter,
+          "Response formatter: \"builder\" (default) builds a json-glib "
+          "document, \"writer\" writes the text directly", "formatter"}
+    ,
     {NULL}
   };
 
@@ -121,6 +136,17 @@ main (gint argc, gchar * argv[])
     return EXIT_SUCCESS;
   }
 
+  if (!formatter || !g_strcmp0 (formatter, "builder")) {
+    gstd_object_set_formatter_type (GSTD_TYPE_JSON_BUILDER);
+  } else if (!g_strcmp0 (formatter, "writer")) {
+    gstd_object_set_formatter_type (GSTD_TYPE_JSON_WRITER);
+  } else {
+    g_printerr ("Unknown formatter \"%s\"\n", formatter);
+    g_free (formatter);
+    return EXIT_FAILURE;
+  }
+  g_free (formatter);
+
   /* If no IPC selected use tcp */
   for (i = 0; i < num_ipcs; i++) {
     g_object_get (G_OBJECT (ipc_array[i]), "enabled", &ipc_selected, NULL);
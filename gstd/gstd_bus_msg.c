@@ -33,6 +33,7 @@ GST_DEBUG_CATEGORY_STATIC(gstd_bus_msg_debug);
 
 static void gstd_bus_msg_dispose (GObject * object);
 static GstdReturnCode gstd_bus_msg_to_string (GstdObject *object, gchar ** outstring);
+static gboolean gstd_bus_msg_is_cacheable (GstdObject * object);
 
 G_DEFINE_TYPE (GstdBusMsg, gstd_bus_msg, GSTD_TYPE_OBJECT)
 
@@ -49,6 +50,7 @@ gstd_bus_msg_class_init (GstdBusMsgClass *klass)
 
   oclass->dispose = gstd_bus_msg_dispose;
   goclass->to_string = GST_DEBUG_FUNCPTR(gstd_bus_msg_to_string);
+  goclass->is_cacheable = GST_DEBUG_FUNCPTR(gstd_bus_msg_is_cacheable);
   klass->to_string = NULL;
   
   /* Initialize debug category with nice colors */
@@ -64,6 +66,13 @@ gstd_bus_msg_init (GstdBusMsg *self)
   GST_INFO_OBJECT(self, "Initializing bus message");
 }
 
+/* Messages are popped from the bus and built anew for every read */
+static gboolean
+gstd_bus_msg_is_cacheable (GstdObject * object)
+{
+  return FALSE;
+}
+
 static void
 gstd_bus_msg_dispose (GObject * object)
 {
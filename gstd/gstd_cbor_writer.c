@@ -0,0 +1,337 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <string.h>
+
+#include "gstd_cbor_writer.h"
+
+/* Gstd Core debugging category */
+GST_DEBUG_CATEGORY_STATIC(gstd_cbor_writer_debug);
+#define GST_CAT_DEFAULT gstd_cbor_writer_debug
+
+/* Initial size of the output buffer */
+#define CBOR_BUFFER_SIZE        1024
+
+/* Major types */
+#define CBOR_UNSIGNED           0
+#define CBOR_NEGATIVE           1
+#define CBOR_TEXT               3
+
+/* Initial bytes */
+#define CBOR_ARRAY_BEGIN        0x9f
+#define CBOR_MAP_BEGIN          0xbf
+#define CBOR_FALSE              0xf4
+#define CBOR_TRUE               0xf5
+#define CBOR_NULL               0xf6
+#define CBOR_FLOAT              0xfa
+#define CBOR_DOUBLE             0xfb
+#define CBOR_BREAK              0xff
+
+typedef struct _GstdCborWriterClass GstdCborWriterClass;
+
+struct _GstdCborWriter
+{
+  GObject parent;
+
+  /* Starts with room for the header */
+  GByteArray *buffer;
+};
+
+struct _GstdCborWriterClass
+{
+  GObjectClass parent_class;
+};
+
+
+static void
+gstd_iformatter_interface_init (GstdIFormatterInterface *iface);
+
+static void
+gstd_cbor_writer_finalize (GObject *object);
+
+G_DEFINE_TYPE_WITH_CODE (GstdCborWriter, gstd_cbor_writer, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (GSTD_TYPE_IFORMATTER,
+                                                gstd_iformatter_interface_init));
+
+static void
+gstd_cbor_writer_class_init (GstdCborWriterClass *klass)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS (klass);
+    guint debug_color;
+
+    object_class->finalize = gstd_cbor_writer_finalize;
+
+    /* Initialize debug category with nice colors */
+    debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+    GST_DEBUG_CATEGORY_INIT (gstd_cbor_writer_debug, "gstdcborwriter", debug_color,
+        "Gstd CBOR writer category");
+}
+
+static GByteArray *
+gstd_cbor_writer_buffer_new (guint size)
+{
+  GByteArray *buffer;
+
+  buffer = g_byte_array_sized_new (size);
+  g_byte_array_set_size (buffer, GSTD_CBOR_HEADER_SIZE);
+
+  return buffer;
+}
+
+static void
+gstd_cbor_writer_init (GstdCborWriter *self)
+{
+  GST_INFO_OBJECT(self,"Initializing CBOR writer");
+
+  self->buffer = gstd_cbor_writer_buffer_new (CBOR_BUFFER_SIZE);
+}
+
+static void
+gstd_cbor_writer_finalize (GObject *object)
+{
+  GstdCborWriter *self = GSTD_CBOR_WRITER (object);
+  GST_DEBUG_OBJECT (self, "finalize");
+
+  g_byte_array_free (self->buffer, TRUE);
+
+  G_OBJECT_CLASS (gstd_cbor_writer_parent_class)->finalize (object);
+}
+
+static void
+gstd_cbor_writer_byte (GstdCborWriter *self, guint8 byte)
+{
+  g_byte_array_append (self->buffer, &byte, 1);
+}
+
+/* Writes the initial bytes of an item with the shortest argument */
+static void
+gstd_cbor_writer_head (GstdCborWriter *self, guint8 major, guint64 value)
+{
+  guint8 head[9];
+  guint size;
+
+  major <<= 5;
+
+  if (value < 24) {
+    head[0] = major | value;
+    size = 1;
+  } else if (value <= G_MAXUINT8) {
+    head[0] = major | 24;
+    head[1] = value;
+    size = 2;
+  } else if (value <= G_MAXUINT16) {
+    head[0] = major | 25;
+    GST_WRITE_UINT16_BE (head + 1, value);
+    size = 3;
+  } else if (value <= G_MAXUINT32) {
+    head[0] = major | 26;
+    GST_WRITE_UINT32_BE (head + 1, value);
+    size = 5;
+  } else {
+    head[0] = major | 27;
+    GST_WRITE_UINT64_BE (head + 1, value);
+    size = 9;
+  }
+
+  g_byte_array_append (self->buffer, head, size);
+}
+
+static void
+gstd_cbor_writer_int (GstdCborWriter *self, gint64 value)
+{
+  if (value < 0) {
+    gstd_cbor_writer_head (self, CBOR_NEGATIVE, -1 - value);
+  } else {
+    gstd_cbor_writer_head (self, CBOR_UNSIGNED, value);
+  }
+}
+
+static void
+gstd_cbor_writer_text (GstdCborWriter *self, const gchar * value)
+{
+  gsize length = strlen (value);
+
+  gstd_cbor_writer_head (self, CBOR_TEXT, length);
+  g_byte_array_append (self->buffer, (const guint8 *) value, length);
+}
+
+static void
+gstd_cbor_writer_begin_object (GstdIFormatter *iface)
+{
+  g_return_if_fail (GSTD_IS_CBOR_WRITER (iface));
+
+  gstd_cbor_writer_byte (GSTD_CBOR_WRITER (iface), CBOR_MAP_BEGIN);
+}
+
+static void
+gstd_cbor_writer_end (GstdIFormatter *iface)
+{
+  g_return_if_fail (GSTD_IS_CBOR_WRITER (iface));
+
+  gstd_cbor_writer_byte (GSTD_CBOR_WRITER (iface), CBOR_BREAK);
+}
+
+static void
+gstd_cbor_writer_begin_array (GstdIFormatter *iface)
+{
+  g_return_if_fail (GSTD_IS_CBOR_WRITER (iface));
+
+  gstd_cbor_writer_byte (GSTD_CBOR_WRITER (iface), CBOR_ARRAY_BEGIN);
+}
+
+static void
+gstd_cbor_writer_set_string_value (GstdIFormatter *iface, const gchar * value)
+{
+  g_return_if_fail (GSTD_IS_CBOR_WRITER (iface));
+  g_return_if_fail (value);
+
+  gstd_cbor_writer_text (GSTD_CBOR_WRITER (iface), value);
+}
+
+static void
+gstd_cbor_writer_set_value (GstdIFormatter *iface, GValue * value)
+{
+  GstdCborWriter *self;
+  guint8 bytes[9];
+  gchar *str_value;
+  union
+  {
+    gfloat f;
+    guint32 u;
+  } f32;
+  union
+  {
+    gdouble d;
+    guint64 u;
+  } f64;
+
+  g_return_if_fail (GSTD_IS_CBOR_WRITER (iface));
+  g_return_if_fail (value);
+
+  self = GSTD_CBOR_WRITER(iface);
+
+  switch(G_VALUE_TYPE(value))
+  {
+    case G_TYPE_BOOLEAN:
+      gstd_cbor_writer_byte (self,
+          g_value_get_boolean (value) ? CBOR_TRUE : CBOR_FALSE);
+      break;
+    case G_TYPE_INT:
+      gstd_cbor_writer_int (self, g_value_get_int (value));
+      break;
+    case G_TYPE_UINT:
+      gstd_cbor_writer_head (self, CBOR_UNSIGNED, g_value_get_uint (value));
+      break;
+    case G_TYPE_INT64:
+      gstd_cbor_writer_int (self, g_value_get_int64 (value));
+      break;
+    case G_TYPE_UINT64:
+      gstd_cbor_writer_head (self, CBOR_UNSIGNED, g_value_get_uint64 (value));
+      break;
+    case G_TYPE_FLOAT:
+      f32.f = g_value_get_float (value);
+      bytes[0] = CBOR_FLOAT;
+      GST_WRITE_UINT32_BE (bytes + 1, f32.u);
+      g_byte_array_append (self->buffer, bytes, 5);
+      break;
+    case G_TYPE_DOUBLE:
+      f64.d = g_value_get_double (value);
+      bytes[0] = CBOR_DOUBLE;
+      GST_WRITE_UINT64_BE (bytes + 1, f64.u);
+      g_byte_array_append (self->buffer, bytes, 9);
+      break;
+    default:
+    /* Everything else is described as text, like the JSON formatters do */
+      str_value = g_strdup_value_contents(value);
+      gstd_cbor_writer_text (self, str_value);
+      g_free (str_value);
+  }
+}
+
+static void
+gstd_cbor_writer_generate (GstdIFormatter *iface, gchar **outstring)
+{
+  GstdCborWriter *self;
+  GByteArray *buffer;
+  guint8 nul = '\0';
+
+  g_return_if_fail (GSTD_IS_CBOR_WRITER (iface));
+  g_return_if_fail (outstring);
+
+  self = GSTD_CBOR_WRITER(iface);
+  buffer = self->buffer;
+
+  GST_WRITE_UINT32_BE (buffer->data, buffer->len - GSTD_CBOR_HEADER_SIZE);
+
+  /* Not part of the output, only there in case it is printed */
+  g_byte_array_append (buffer, &nul, 1);
+
+  /* Hand the buffer over and start the next one at the same size */
+  self->buffer = gstd_cbor_writer_buffer_new (MAX (buffer->len,
+          CBOR_BUFFER_SIZE));
+  *outstring = (gchar *) g_byte_array_free (buffer, FALSE);
+}
+
+static void
+gstd_cbor_writer_set_pretty (GstdIFormatter *iface, gboolean pretty)
+{
+  /* Binary output has no layout */
+}
+
+gsize
+gstd_cbor_writer_get_size (const gchar * output)
+{
+  g_return_val_if_fail (output, 0);
+
+  return GSTD_CBOR_HEADER_SIZE + GST_READ_UINT32_BE (output);
+}
+
+void
+gstd_cbor_writer_add_encoded (GstdIFormatter * iface, const gchar * output)
+{
+  GstdCborWriter *self;
+
+  g_return_if_fail (GSTD_IS_CBOR_WRITER (iface));
+
+  self = GSTD_CBOR_WRITER(iface);
+
+  if (!output) {
+    gstd_cbor_writer_byte (self, CBOR_NULL);
+    return;
+  }
+
+  g_byte_array_append (self->buffer,
+      (const guint8 *) output + GSTD_CBOR_HEADER_SIZE,
+      GST_READ_UINT32_BE (output));
+}
+
+static void
+gstd_iformatter_interface_init (GstdIFormatterInterface *iface)
+{
+  iface->begin_object = gstd_cbor_writer_begin_object;
+  iface->end_object = gstd_cbor_writer_end;
+  iface->begin_array = gstd_cbor_writer_begin_array;
+  iface->end_array = gstd_cbor_writer_end;
+  /* Map keys are plain text items */
+  iface->set_member_name = gstd_cbor_writer_set_string_value;
+  iface->set_string_value = gstd_cbor_writer_set_string_value;
+  iface->set_value = gstd_cbor_writer_set_value;
+  iface->generate = gstd_cbor_writer_generate;
+  iface->set_pretty = gstd_cbor_writer_set_pretty;
+}
@@ -0,0 +1,83 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_CBOR_WRITER_H__
+#define __GSTD_CBOR_WRITER_H__
+
+#include <gst/gst.h>
+
+#include "gstd_iformatter.h"
+
+G_BEGIN_DECLS
+
+/*
+ * Type declaration.
+ */
+#define GSTD_TYPE_CBOR_WRITER \
+  (gstd_cbor_writer_get_type())
+#define GSTD_CBOR_WRITER(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_CBOR_WRITER,GstdCborWriter))
+#define GSTD_CBOR_WRITER_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_CBOR_WRITER,GstdCborWriterClass))
+#define GSTD_IS_CBOR_WRITER(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_CBOR_WRITER))
+#define GSTD_IS_CBOR_WRITER_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_CBOR_WRITER))
+#define GSTD_CBOR_WRITER_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_CBOR_WRITER, GstdCborWriterClass))
+
+/*
+ * The output is binary, so it carries its own size: a 32 bit big endian
+ * length followed by that many bytes of CBOR (RFC 7049). This is also a
+ * complete frame of the framed socket protocol.
+ */
+#define GSTD_CBOR_HEADER_SIZE 4
+
+typedef struct _GstdCborWriter GstdCborWriter;
+
+/**
+ * GstdCborWriter:
+ * A formatter encoding CBOR. Booleans, integers and floating point
+ * values are encoded natively, objects and arrays as indefinite length
+ * maps and arrays.
+ */
+GType gstd_cbor_writer_get_type();
+
+/**
+ * gstd_cbor_writer_get_size:
+ * @output: The output of a #GstdCborWriter
+ *
+ * Returns: The size of @output, including its header
+ */
+gsize gstd_cbor_writer_get_size (const gchar * output);
+
+/**
+ * gstd_cbor_writer_add_encoded:
+ * @self: A #GstdCborWriter
+ * @output: (nullable): The output of another #GstdCborWriter
+ *
+ * Adds an already encoded item as the next value, or null if @output is
+ * NULL.
+ */
+void gstd_cbor_writer_add_encoded (GstdIFormatter * self,
+    const gchar * output);
+
+G_END_DECLS
+
+#endif // __GSTD_CBOR_WRITER_H__
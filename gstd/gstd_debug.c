@@ -137,7 +137,7 @@ gstd_debug_init (GstdDebug * self)
   self->threshold = debug_obtain_default_level ();
 
   gstd_object_set_reader (GSTD_OBJECT(self),
-      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+      gstd_object_get_strategy (GSTD_TYPE_PROPERTY_READER));
 }
 
 static void
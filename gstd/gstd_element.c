@@ -32,12 +32,8 @@
 #include "gstd_event_handler.h"
 
 #include "gstd_iformatter.h"
-#include "gstd_json_builder.h"
 #include "gstd_property_reader.h"
-#include "gstd_property_boolean.h"
-#include "gstd_property_string.h"
-#include "gstd_property_int.h"
-#include "gstd_property_enum.h"
+#include "gstd_property_list.h"
 #include "gstd_list_reader.h"
 
 enum
@@ -69,7 +65,6 @@ struct _GstdElement
    */
   GstElement *element;
 
-  GstdIFormatter * formatter;
     /**
    * The gstd event handler for this element
    */
@@ -97,11 +92,7 @@ static void
 gstd_element_set_property (GObject *, guint, const GValue *, GParamSpec *);
 static void gstd_element_dispose (GObject *);
 static GstdReturnCode gstd_element_to_string (GstdObject *, gchar **);
-void gstd_element_internal_to_string (GstdElement *, gchar **);
-static GstdReturnCode
-gstd_element_fill_properties (GstdElement * self);
-static GType
-gstd_element_property_get_type (GType g_type);
+static void gstd_element_format_internal (GstdElement *);
 static void
 gstd_element_class_init (GstdElementClass * klass)
 {
@@ -151,15 +142,10 @@ gstd_element_init (GstdElement * self)
   GST_INFO_OBJECT (self, "Initializing element");
   self->element = GSTD_ELEMENT_DEFAULT_GSTELEMENT;
   self->event_handler = NULL;
-  self->formatter = g_object_new (GSTD_TYPE_JSON_BUILDER, NULL);
 
   gstd_object_set_reader (GSTD_OBJECT(self),
-      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
-
-  self->element_properties = GSTD_LIST(g_object_new (GSTD_TYPE_LIST, "name", "element_properties", "node-type", GSTD_TYPE_PROPERTY, "flags", GSTD_PARAM_READ, NULL));
-
-  gstd_object_set_reader (GSTD_OBJECT(self->element_properties),
-      g_object_new(GSTD_TYPE_LIST_READER, NULL));
+      gstd_object_get_strategy (GSTD_TYPE_PROPERTY_READER));
+  self->element_properties = NULL;
 }
 
 static void
@@ -179,9 +165,10 @@ gstd_element_dispose (GObject * object)
     self->event_handler = NULL;
   }
 
-  /* Free formatter */
-  g_object_unref (self->formatter);
-  g_object_unref (self->element_properties);
+  if (self->element_properties) {
+    g_object_unref (self->element_properties);
+    self->element_properties = NULL;
+  }
 
   G_OBJECT_CLASS (gstd_element_parent_class)->dispose (object);
 }
@@ -233,7 +220,14 @@ gstd_element_set_property (GObject * object,
       GST_DEBUG_OBJECT (self, "Setting element %p (%s)", self->element,
           GST_OBJECT_NAME (self->element));
 
-      gstd_element_fill_properties(self);
+      /* Property nodes are created as they are accessed */
+      if (self->element_properties) {
+        g_object_unref (self->element_properties);
+      }
+      self->element_properties = GSTD_LIST(g_object_new (GSTD_TYPE_PROPERTY_LIST, "name", "element_properties", "node-type", GSTD_TYPE_PROPERTY, "flags", GSTD_PARAM_READ, "target", self->element, NULL));
+
+      gstd_object_set_reader (GSTD_OBJECT(self->element_properties),
+          gstd_object_get_strategy (GSTD_TYPE_LIST_READER));
       break;
     default:
       /* We don't have any other property... */
@@ -246,169 +240,67 @@ static GstdReturnCode
 gstd_element_to_string (GstdObject * object, gchar ** outstring)
 {
   GstdElement *self = GSTD_ELEMENT (object);
-  gchar *props;
-  gchar *internal;
 
   g_return_val_if_fail (GSTD_IS_OBJECT (object), GSTD_NULL_ARGUMENT);
   g_warn_if_fail (!*outstring);
 
-  /* Lets leverage the parent's class implementation */
-  GSTD_OBJECT_CLASS (gstd_element_parent_class)->to_string (GSTD_OBJECT
-      (object), &props);
-  // A little hack to remove the last bracket
-  props[strlen (props) - 2] = '\0';
+  /* The properties of the object itself, then those of the internal GST
+   * element, in a single object */
+  gstd_iformatter_begin_object (object->formatter);
+  gstd_object_format_properties (object);
+  gstd_element_format_internal (self);
+  gstd_iformatter_end_object (object->formatter);
 
-  // Now parse the properties of the internal GST element
-  gstd_element_internal_to_string (self, &internal);
-
-  *outstring = g_strdup_printf ("%s,%s", props, internal);
-  g_free (props);
-  g_free (internal);
+  gstd_iformatter_generate (object->formatter, outstring);
 
   return GSTD_EOK;
 }
 
-void
-gstd_element_internal_to_string (GstdElement * self, gchar ** outstring)
+/* Adds the "element_properties" member to the object being described */
+static void
+gstd_element_format_internal (GstdElement * self)
 {
-  GParamSpec **properties;
+  const GstdSchema *schema;
+  GParamSpec *pspec;
   GValue value = G_VALUE_INIT;
-  GValue bool_value = G_VALUE_INIT;
-  GValue flags = G_VALUE_INIT;
-  gchar *sflags;
-  guint n, i;
-  const gchar *typename;
+  GstdIFormatter *formatter;
+  guint fields;
+  guint i;
 
   g_return_if_fail (GSTD_IS_OBJECT(self));
 
-  gstd_iformatter_begin_object (self->formatter);
-  gstd_iformatter_set_member_name (self->formatter,"element_properties");
-  gstd_iformatter_begin_array (self->formatter);
-  
-  properties = g_object_class_list_properties(G_OBJECT_GET_CLASS(self->element), &n);
-  for (i=0; i<n; i++) {
-    /* Describe each parameter using a structure */
-    gstd_iformatter_begin_object (self->formatter);
-
-    gstd_iformatter_set_member_name (self->formatter,"name");
+  formatter = GSTD_OBJECT (self)->formatter;
+  fields = gstd_object_get_fields ();
+  schema = gstd_schema_get (G_OBJECT_TYPE (self->element));
 
-    gstd_iformatter_set_string_value (self->formatter, properties[i]->name);
-
-    typename = g_type_name(properties[i]->value_type);
-
-    g_value_init (&value, properties[i]->value_type);
-    g_object_get_property(G_OBJECT(self->element), properties[i]->name, &value);
-
-    gstd_iformatter_set_member_name (self->formatter,"value");
-    gstd_iformatter_set_value (self->formatter, &value);
-
-    gstd_iformatter_set_member_name (self->formatter, "param_spec");
-    /* Describe the parameter specs using a structure */
-    gstd_iformatter_begin_object (self->formatter);
-
-    g_value_unset(&value);
-
-    g_value_init (&flags, GSTD_TYPE_PARAM_FLAGS);
-    g_value_set_flags (&flags, properties[i]->flags);
-    sflags = g_strdup_value_contents(&flags);
-    g_value_unset(&flags);
-
-    gstd_iformatter_set_member_name (self->formatter, "blurb");
-    gstd_iformatter_set_string_value (self->formatter,properties[i]->_blurb);
+  gstd_iformatter_set_member_name (formatter,"element_properties");
+  gstd_iformatter_begin_array (formatter);
+  
+  for (i=0; i<schema->n_properties; i++) {
+    pspec = schema->properties[i].pspec;
 
-    gstd_iformatter_set_member_name (self->formatter, "type");
-    gstd_iformatter_set_string_value (self->formatter,typename);
+    /* Describe each parameter using a structure */
+    gstd_iformatter_begin_object (formatter);
 
-    gstd_iformatter_set_member_name (self->formatter, "access");
-    gstd_iformatter_set_string_value (self->formatter,sflags);
+    if (fields & GSTD_FIELD_NAME) {
+      gstd_iformatter_set_member_name (formatter,"name");
+      gstd_iformatter_set_string_value (formatter, pspec->name);
+    }
 
-    gstd_iformatter_set_member_name (self->formatter, "construct");
+    if (fields & GSTD_FIELD_VALUE) {
+      g_value_init (&value, pspec->value_type);
+      g_object_get_property(G_OBJECT(self->element), pspec->name, &value);
 
-    g_value_init (&bool_value, G_TYPE_BOOLEAN);
-    g_value_set_boolean(&bool_value,GSTD_PARAM_IS_DELETE(properties[i]->flags));
-    gstd_iformatter_set_value (self->formatter, &bool_value);
-    g_value_unset(&bool_value);
-    /* Close parameter specs structure */
-    gstd_iformatter_end_object (self->formatter);
+      gstd_iformatter_set_member_name (formatter,"value");
+      gstd_iformatter_set_value (formatter, &value);
+      g_value_unset(&value);
+    }
 
-    g_free (sflags);
+    gstd_object_format_param_spec (formatter, &schema->properties[i]);
 
     /* Close parameter structure */
-    gstd_iformatter_end_object (self->formatter);
+    gstd_iformatter_end_object (formatter);
   }
-  g_free (properties);
-
-  gstd_iformatter_end_array (self->formatter); 
-  gstd_iformatter_end_object (self->formatter);
 
-  gstd_iformatter_generate (self->formatter, outstring);
-}
-
-static GstdReturnCode
-gstd_element_fill_properties (GstdElement *self)
-{
-  GParamSpec **properties_array;
-  guint n_properties;
-  GstdObject *element_property;
-  GType type;
-  GObjectClass * g_class;
-  guint i;
-  g_class = G_OBJECT_GET_CLASS(self->element);
-
-  g_return_val_if_fail (GSTD_IS_ELEMENT(self), GSTD_NULL_ARGUMENT);
-
-  GST_DEBUG_OBJECT(self, "Gathering \"%s\" properties", GST_OBJECT_NAME(self));
-
-  properties_array = g_object_class_list_properties(g_class, &n_properties);
-
-  for (i = 0; i < n_properties; ++i){
-    type = gstd_element_property_get_type(properties_array[i]->value_type);
-    element_property = g_object_new(type, "name",
-        properties_array[i]->name, "target", self->element, NULL);
-
-    gstd_list_append_child (self->element_properties, element_property);
-  }
-
-  g_free (properties_array);
-
-  return GSTD_EOK;
-}
-
-static GType
-gstd_element_property_get_type (GType g_type) {
-
-  //FIXME:
-  //I just found a way to handle all types in a generic way, hence,
-  //the base property class can handle them all. I don't want to remove
-  //specific type sublasses because the to_string method may require to
-  //add details. For example, int properties can display their max and min
-  //values, flags and enums could display the options, etc... Similar to
-  //what gst-inspect does
-  return GSTD_TYPE_PROPERTY;
-
-  switch (g_type) {
-    case G_TYPE_BOOLEAN:
-    {
-      return GSTD_TYPE_PROPERTY_BOOLEAN;
-    }
-    case G_TYPE_INT:
-    case G_TYPE_UINT:
-    case G_TYPE_UINT64:
-    case G_TYPE_INT64:
-    {
-      return GSTD_TYPE_PROPERTY_INT;
-    }
-    case G_TYPE_STRING:
-    {
-	return  GSTD_TYPE_PROPERTY_STRING;
-    }
-    default:
-    {
-      if (G_TYPE_IS_ENUM(g_type)) {
-	return GSTD_TYPE_PROPERTY_ENUM;
-      } else  {
-	return GSTD_TYPE_PROPERTY;
-      }
-    }
-  }
+  gstd_iformatter_end_array (formatter);
 }
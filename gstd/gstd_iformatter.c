@@ -84,3 +84,9 @@ gstd_iformatter_default_init (GstdIFormatterInterface *iface)
   /* Add properties and signals to the interface here */
 }
 
+void
+gstd_iformatter_set_pretty (GstdIFormatter *self, gboolean pretty)
+{
+  g_return_if_fail (self);
+  GSTD_IFORMATTER_GET_INTERFACE (self)->set_pretty (self, pretty);
+}
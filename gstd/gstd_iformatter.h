@@ -55,6 +55,8 @@ struct _GstdIFormatterInterface
   void (*set_value) (GstdIFormatter *self, GValue *value);
 
   void (*generate) (GstdIFormatter *self, gchar **outstring);
+
+  void (*set_pretty) (GstdIFormatter *self, gboolean pretty);
 };
 
 void gstd_iformatter_begin_object (GstdIFormatter *self);
@@ -73,6 +75,10 @@ void gstd_iformatter_set_value (GstdIFormatter *self, GValue *value);
 
 void gstd_iformatter_generate (GstdIFormatter *self, gchar **outstring);
 
+/* Indents the output, or leaves out every optional whitespace. Must be
+ * set before describing anything, applies until changed */
+void gstd_iformatter_set_pretty (GstdIFormatter *self, gboolean pretty);
+
 G_END_DECLS
 
 
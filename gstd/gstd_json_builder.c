@@ -30,7 +30,7 @@ GST_DEBUG_CATEGORY_STATIC(gstd_json_builder_debug);
 #define JSON_INDENT_CHAR   ' '
 /* Sets the number of repetitions for each indentation level. */
 #define JSON_INDENT_LEVEL  4
-/* Sets whether the generated JSON should be pretty printed */
+/* Sets whether the generated JSON is pretty printed by default */
 #define JSON_SET_PRETTY    TRUE
 
 
@@ -44,6 +44,7 @@ struct _GstdJsonBuilder
 {
   GObject parent;
   JsonBuilder * json_builder;
+  gboolean pretty;
 };
 
 struct _GstdJsonBuilderClass
@@ -82,6 +83,7 @@ gstd_json_builder_init (GstdJsonBuilder *self)
   GST_INFO_OBJECT(self,"Initializing Json builder");
   
   self->json_builder = json_builder_new ();
+  self->pretty = JSON_SET_PRETTY;
 }
 
 static void
@@ -229,7 +231,7 @@ gstd_json_builder_generate (GstdIFormatter *iface, gchar **outstring)
   /* Configure json format */
   json_generator_set_indent_char (json_generator,JSON_INDENT_CHAR);
   json_generator_set_indent (json_generator,JSON_INDENT_LEVEL);
-  json_generator_set_pretty (json_generator,JSON_SET_PRETTY);
+  json_generator_set_pretty (json_generator,self->pretty);
 
   /* Generates a JSON data stream from generator and returns it as a buffer */
   json_stream = json_generator_to_data (json_generator,&json_stream_length);
@@ -242,6 +244,17 @@ gstd_json_builder_generate (GstdIFormatter *iface, gchar **outstring)
   *outstring = json_stream;
 }
 
+static void
+gstd_json_builder_set_pretty (GstdIFormatter *iface, gboolean pretty)
+{
+  GstdJsonBuilder *self;
+
+  g_return_if_fail (GSTD_IS_JSON_BUILDER (iface));
+
+  self = GSTD_JSON_BUILDER(iface);
+  self->pretty = pretty;
+}
+
 static void
 gstd_json_builder_finalize( GObject *object)
 {
@@ -263,4 +276,5 @@ gstd_iformatter_interface_init (GstdIFormatterInterface *iface)
   iface->set_string_value = gstd_json_set_string_value;
   iface->set_value = gstd_json_set_value;
   iface->generate = gstd_json_builder_generate;
+  iface->set_pretty = gstd_json_builder_set_pretty;
 }
@@ -0,0 +1,412 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <string.h>
+#include <math.h>
+
+#include "gstd_json_writer.h"
+#include "gstd_iformatter.h"
+
+/* Gstd Core debugging category */
+GST_DEBUG_CATEGORY_STATIC(gstd_json_writer_debug);
+#define GST_CAT_DEFAULT gstd_json_writer_debug
+
+/* Sets the number of spaces for each indentation level. */
+#define JSON_INDENT_LEVEL  4
+/* Sets whether the generated JSON is pretty printed by default */
+#define JSON_SET_PRETTY    TRUE
+/* Initial size of the output buffer */
+#define JSON_BUFFER_SIZE   1024
+
+/* Byte-wise tests over a 64 bit word, true if any of its bytes matches */
+#define JSON_ONES          G_GUINT64_CONSTANT (0x0101010101010101)
+#define JSON_HIGHS         G_GUINT64_CONSTANT (0x8080808080808080)
+#define JSON_HAS_LESS(w,b) (((w) - JSON_ONES * (b)) & ~(w) & JSON_HIGHS)
+#define JSON_HAS_BYTE(w,b) JSON_HAS_LESS ((w) ^ (JSON_ONES * (b)), 1)
+
+typedef struct _GstdJsonWriterClass GstdJsonWriterClass;
+
+struct _GstdJsonWriter
+{
+  GObject parent;
+
+  GString *buffer;
+
+  /* Number of members written so far in each open object or array */
+  GArray *levels;
+
+  /* A member name was just written, its value follows */
+  gboolean member;
+
+  gboolean pretty;
+};
+
+struct _GstdJsonWriterClass
+{
+  GObjectClass parent_class;
+};
+
+
+static void
+gstd_iformatter_interface_init (GstdIFormatterInterface *iface);
+
+static void
+gstd_json_writer_finalize (GObject *object);
+
+G_DEFINE_TYPE_WITH_CODE (GstdJsonWriter, gstd_json_writer, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (GSTD_TYPE_IFORMATTER,
+                                                gstd_iformatter_interface_init));
+
+static void
+gstd_json_writer_class_init (GstdJsonWriterClass *klass)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS (klass);
+    guint debug_color;
+
+    object_class->finalize = gstd_json_writer_finalize;
+
+    /* Initialize debug category with nice colors */
+    debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+    GST_DEBUG_CATEGORY_INIT (gstd_json_writer_debug, "gstdjsonwriter", debug_color,
+        "Gstd JSON writer category");
+}
+
+static void
+gstd_json_writer_init (GstdJsonWriter *self)
+{
+  GST_INFO_OBJECT(self,"Initializing Json writer");
+
+  self->buffer = g_string_sized_new (JSON_BUFFER_SIZE);
+  self->levels = g_array_new (FALSE, FALSE, sizeof (guint));
+  self->member = FALSE;
+  self->pretty = JSON_SET_PRETTY;
+}
+
+static void
+gstd_json_writer_finalize (GObject *object)
+{
+  GstdJsonWriter *self = GSTD_JSON_WRITER (object);
+  GST_DEBUG_OBJECT (self, "finalize");
+
+  g_string_free (self->buffer, TRUE);
+  g_array_free (self->levels, TRUE);
+
+  G_OBJECT_CLASS (gstd_json_writer_parent_class)->finalize (object);
+}
+
+static void
+gstd_json_writer_indent (GstdJsonWriter *self)
+{
+  guint depth;
+
+  if (!self->pretty) {
+    return;
+  }
+
+  depth = self->levels->len * JSON_INDENT_LEVEL;
+  g_string_append_c (self->buffer, '\n');
+  while (depth--) {
+    g_string_append_c (self->buffer, ' ');
+  }
+}
+
+/* Separates a new member or element from the previous one */
+static void
+gstd_json_writer_next (GstdJsonWriter *self)
+{
+  guint *count;
+
+  if (self->member) {
+    self->member = FALSE;
+    return;
+  }
+
+  if (0 == self->levels->len) {
+    return;
+  }
+
+  count = &g_array_index (self->levels, guint, self->levels->len - 1);
+  if ((*count)++) {
+    g_string_append_c (self->buffer, ',');
+  }
+  gstd_json_writer_indent (self);
+}
+
+static void
+gstd_json_writer_escape (GstdJsonWriter *self, const gchar * value)
+{
+  GString *buffer = self->buffer;
+  const gchar *run;
+  const gchar *end;
+  const gchar *p;
+  guint64 word;
+  guchar c;
+
+  g_string_append_c (buffer, '"');
+
+  run = p = value;
+  end = value + strlen (value);
+  while (p < end) {
+    /* Skip eight bytes at a time while none of them needs escaping */
+    while (p + sizeof (word) <= end) {
+      memcpy (&word, p, sizeof (word));
+      if (JSON_HAS_LESS (word, 0x20) || JSON_HAS_BYTE (word, '"')
+          || JSON_HAS_BYTE (word, '\\')) {
+        break;
+      }
+      p += sizeof (word);
+    }
+
+    /* Then find the byte that stopped the scan */
+    while (p < end && (c = *p) >= 0x20 && '"' != c && '\\' != c) {
+      p++;
+    }
+
+    g_string_append_len (buffer, run, p - run);
+    if (p == end) {
+      break;
+    }
+
+    c = *p;
+    switch (c) {
+      case '"':
+        g_string_append (buffer, "\\\"");
+        break;
+      case '\\':
+        g_string_append (buffer, "\\\\");
+        break;
+      case '\b':
+        g_string_append (buffer, "\\b");
+        break;
+      case '\f':
+        g_string_append (buffer, "\\f");
+        break;
+      case '\n':
+        g_string_append (buffer, "\\n");
+        break;
+      case '\r':
+        g_string_append (buffer, "\\r");
+        break;
+      case '\t':
+        g_string_append (buffer, "\\t");
+        break;
+      default:
+        g_string_append_printf (buffer, "\\u%04x", c);
+        break;
+    }
+    run = ++p;
+  }
+
+  g_string_append_c (buffer, '"');
+}
+
+static void
+gstd_json_writer_begin_object (GstdIFormatter *iface)
+{
+  GstdJsonWriter *self;
+  guint count = 0;
+
+  g_return_if_fail (GSTD_IS_JSON_WRITER (iface));
+
+  self = GSTD_JSON_WRITER(iface);
+  gstd_json_writer_next (self);
+  g_string_append_c (self->buffer, '{');
+  g_array_append_val (self->levels, count);
+}
+
+static void
+gstd_json_writer_end (GstdJsonWriter *self, gchar close)
+{
+  guint count;
+
+  g_return_if_fail (self->levels->len);
+
+  count = g_array_index (self->levels, guint, self->levels->len - 1);
+  g_array_set_size (self->levels, self->levels->len - 1);
+
+  if (count) {
+    gstd_json_writer_indent (self);
+  }
+  g_string_append_c (self->buffer, close);
+}
+
+static void
+gstd_json_writer_end_object (GstdIFormatter *iface)
+{
+  g_return_if_fail (GSTD_IS_JSON_WRITER (iface));
+
+  gstd_json_writer_end (GSTD_JSON_WRITER(iface), '}');
+}
+
+static void
+gstd_json_writer_begin_array (GstdIFormatter *iface)
+{
+  GstdJsonWriter *self;
+  guint count = 0;
+
+  g_return_if_fail (GSTD_IS_JSON_WRITER (iface));
+
+  self = GSTD_JSON_WRITER(iface);
+  gstd_json_writer_next (self);
+  g_string_append_c (self->buffer, '[');
+  g_array_append_val (self->levels, count);
+}
+
+static void
+gstd_json_writer_end_array (GstdIFormatter *iface)
+{
+  g_return_if_fail (GSTD_IS_JSON_WRITER (iface));
+
+  gstd_json_writer_end (GSTD_JSON_WRITER(iface), ']');
+}
+
+static void
+gstd_json_writer_set_member_name (GstdIFormatter *iface, const gchar * name)
+{
+  GstdJsonWriter *self;
+
+  g_return_if_fail (GSTD_IS_JSON_WRITER (iface));
+  g_return_if_fail (name);
+
+  self = GSTD_JSON_WRITER(iface);
+  gstd_json_writer_next (self);
+  gstd_json_writer_escape (self, name);
+  g_string_append (self->buffer, self->pretty ? " : " : ":");
+  self->member = TRUE;
+}
+
+static void
+gstd_json_writer_set_string_value (GstdIFormatter *iface, const gchar * value)
+{
+  GstdJsonWriter *self;
+
+  g_return_if_fail (GSTD_IS_JSON_WRITER (iface));
+  g_return_if_fail (value);
+
+  self = GSTD_JSON_WRITER(iface);
+  gstd_json_writer_next (self);
+  gstd_json_writer_escape (self, value);
+}
+
+static void
+gstd_json_writer_set_double (GstdJsonWriter *self, gdouble value)
+{
+  gchar buf[G_ASCII_DTOSTR_BUF_SIZE];
+
+  /* JSON has no representation for them */
+  if (isnan (value) || isinf (value)) {
+    g_string_append (self->buffer, "null");
+    return;
+  }
+
+  g_string_append (self->buffer, g_ascii_dtostr (buf, sizeof (buf), value));
+}
+
+static void
+gstd_json_writer_set_value (GstdIFormatter *iface, GValue * value)
+{
+  GstdJsonWriter *self;
+  gchar *str_value;
+
+  g_return_if_fail (GSTD_IS_JSON_WRITER (iface));
+  g_return_if_fail (value);
+
+  self = GSTD_JSON_WRITER(iface);
+  gstd_json_writer_next (self);
+
+  switch(G_VALUE_TYPE(value))
+  {
+    /* Since Json format only supports string, boolean, integer and
+     * double, only related gtypes are cast to this formats
+     */
+    case G_TYPE_BOOLEAN:
+      g_string_append (self->buffer,
+          g_value_get_boolean (value) ? "true" : "false");
+      break;
+    case G_TYPE_INT:
+      g_string_append_printf (self->buffer, "%d", g_value_get_int (value));
+      break;
+    case G_TYPE_UINT:
+      g_string_append_printf (self->buffer, "%u", g_value_get_uint (value));
+      break;
+    case G_TYPE_INT64:
+      g_string_append_printf (self->buffer, "%" G_GINT64_FORMAT,
+          g_value_get_int64 (value));
+      break;
+    case G_TYPE_UINT64:
+      g_string_append_printf (self->buffer, "%" G_GUINT64_FORMAT,
+          g_value_get_uint64 (value));
+      break;
+    case G_TYPE_FLOAT:
+      gstd_json_writer_set_double (self, g_value_get_float (value));
+      break;
+    case G_TYPE_DOUBLE:
+      gstd_json_writer_set_double (self, g_value_get_double (value));
+      break;
+    default:
+    /* if the gvalue is not a boolean, integer or float point value, then
+     * gvalue is converted to string
+     */
+      str_value = g_strdup_value_contents(value);
+      gstd_json_writer_escape (self, str_value);
+      g_free (str_value);
+  }
+}
+
+static void
+gstd_json_writer_generate (GstdIFormatter *iface, gchar **outstring)
+{
+  GstdJsonWriter *self;
+  gsize size;
+
+  g_return_if_fail (GSTD_IS_JSON_WRITER (iface));
+  g_return_if_fail (outstring);
+
+  self = GSTD_JSON_WRITER(iface);
+
+  /* Hand the buffer over and start the next one at the same size */
+  size = self->buffer->len + 1;
+  *outstring = g_string_free (self->buffer, FALSE);
+  self->buffer = g_string_sized_new (MAX (size, JSON_BUFFER_SIZE));
+
+  g_array_set_size (self->levels, 0);
+  self->member = FALSE;
+}
+
+static void
+gstd_json_writer_set_pretty (GstdIFormatter *iface, gboolean pretty)
+{
+  g_return_if_fail (GSTD_IS_JSON_WRITER (iface));
+
+  GSTD_JSON_WRITER(iface)->pretty = pretty;
+}
+
+static void
+gstd_iformatter_interface_init (GstdIFormatterInterface *iface)
+{
+  iface->begin_object = gstd_json_writer_begin_object;
+  iface->end_object = gstd_json_writer_end_object;
+  iface->begin_array = gstd_json_writer_begin_array;
+  iface->end_array = gstd_json_writer_end_array;
+  iface->set_member_name = gstd_json_writer_set_member_name;
+  iface->set_string_value = gstd_json_writer_set_string_value;
+  iface->set_value = gstd_json_writer_set_value;
+  iface->generate = gstd_json_writer_generate;
+  iface->set_pretty = gstd_json_writer_set_pretty;
+}
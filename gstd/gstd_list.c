@@ -27,6 +27,7 @@
 
 #include "gstd_list.h"
 #include "gstd_object.h"
+#include "gstd_iformatter.h"
 
 enum
 {
@@ -47,13 +48,18 @@ GST_DEBUG_CATEGORY_STATIC (gstd_list_debug);
 #define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
 
 /* VTable */
-static gint gstd_list_find_node (gconstpointer, gconstpointer);
 static GstdReturnCode
 gstd_list_create (GstdObject * object, const gchar * name,
     const gchar * description);
 static GstdReturnCode
 gstd_list_delete (GstdObject * object, const gchar * name);
 static GstdReturnCode gstd_list_to_string (GstdObject *, gchar **);
+static GstdReturnCode gstd_list_format_range (GstdList *, guint, guint,
+    const gchar *, gchar **);
+static GstdObject *gstd_list_find_child_default (GstdList * self,
+    const gchar * name);
+static void gstd_list_foreach_name_default (GstdList * self,
+    GstdListNameFunc func, gpointer user_data);
 
 G_DEFINE_TYPE (GstdList, gstd_list, GSTD_TYPE_OBJECT);
 
@@ -102,6 +108,9 @@ gstd_list_class_init (GstdListClass * klass)
   gstd_object_class->delete = gstd_list_delete;
   gstd_object_class->to_string = gstd_list_to_string;
 
+  klass->find_child = gstd_list_find_child_default;
+  klass->foreach_name = gstd_list_foreach_name_default;
+
   /* Initialize debug category with nice colors */
   debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
   GST_DEBUG_CATEGORY_INIT (gstd_list_debug, "gstdlist", debug_color,
@@ -112,9 +121,13 @@ static void
 gstd_list_init (GstdList * self)
 {
   GST_INFO_OBJECT (self, "Initializing list");
-  self->list = NULL;
+  self->list = g_queue_new ();
+  /* Deleters may free the child along with its name, so keys are
+   * copies */
+  self->index = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
   self->count = GSTD_LIST_DEFAULT_COUNT;
   self->node_type = GSTD_LIST_DEFAULT_NODE_TYPE;
+  self->generation = 0;
 }
 
 static void
@@ -125,7 +138,9 @@ gstd_list_dispose (GObject * object)
   GST_INFO_OBJECT (self, "Disposing %s list", GSTD_OBJECT_NAME (self));
 
   if (self->list) {
-    g_list_free_full (self->list, g_object_unref);
+    g_hash_table_destroy (self->index);
+    self->index = NULL;
+    g_queue_free_full (self->list, g_object_unref);
     self->list = NULL;
   }
 
@@ -182,17 +197,6 @@ gstd_list_set_property (GObject * object,
   }
 }
 
-static gint
-gstd_list_find_node (gconstpointer _obj, gconstpointer _name)
-{
-  GstdObject *obj = GSTD_OBJECT (_obj);
-  gchar *name = (gchar *) _name;
-
-  GST_LOG ("Comparing %s vs %s", GSTD_OBJECT_NAME (obj), name);
-
-  return strcmp (GSTD_OBJECT_NAME (obj), name);
-}
-
 static GstdReturnCode
 gstd_list_create (GstdObject * object, const gchar * name,
     const gchar * description)
@@ -214,8 +218,6 @@ gstd_list_create (GstdObject * object, const gchar * name,
     ret = GSTD_BAD_COMMAND;
     goto error;
   }
- 
-  self->count++;
 
   if (!gstd_list_append_child (self, out)) {
     g_object_unref (out);
@@ -252,7 +254,7 @@ gstd_list_delete (GstdObject * object, const gchar * node)
   g_return_val_if_fail (object->deleter, GSTD_MISSING_INITIALIZATION);
 
   /* Test if the resource to delete exists */
-  found = g_list_find_custom (self->list, node, gstd_list_find_node);
+  found = g_hash_table_lookup (self->index, node);
 
   if (!found)
     goto unexisting;
@@ -266,9 +268,13 @@ gstd_list_delete (GstdObject * object, const gchar * node)
   if (ret)
     return ret;
 
-  self->count--;
+  g_hash_table_remove (self->index, node);
+  g_queue_delete_link (self->list, found);
+  self->count = g_queue_get_length (self->list);
 
-  self->list = g_list_delete_link (self->list, found);
+  /* Creating never changes what an existing path resolves to, only
+   * deleting does */
+  g_atomic_int_inc (&self->generation);
 
   return ret;
 
@@ -283,43 +289,112 @@ unexisting:
 static GstdReturnCode
 gstd_list_to_string (GstdObject * object, gchar ** outstring)
 {
-  GstdList *self = GSTD_LIST (object);
-  gchar *props;
-  gchar *acc;
-  gchar *node;
-  GList *list;
-  gchar *separator;
+  return gstd_list_format_range (GSTD_LIST (object), 0, 0, NULL, outstring);
+}
 
-  g_return_val_if_fail (GSTD_IS_OBJECT (object), GSTD_NULL_ARGUMENT);
-  g_warn_if_fail (!*outstring);
+/* A page of nodes being serialized */
+typedef struct _GstdListPage
+{
+  GstdIFormatter *formatter;
+  guint offset;
+  guint limit;
+  const gchar *prefix;
+  guint skipped;
+  guint listed;
+} GstdListPage;
+
+static gboolean
+gstd_list_format_node (const gchar * name, gpointer user_data)
+{
+  GstdListPage *page = user_data;
+
+  if (page->limit && page->listed == page->limit) {
+    return FALSE;
+  }
+
+  if (page->prefix && !g_str_has_prefix (name, page->prefix)) {
+    return TRUE;
+  }
 
-  /* Lets leverage the parent's class implementation */
-  GSTD_OBJECT_CLASS (gstd_list_parent_class)->to_string (GSTD_OBJECT (object),
-      &props);
-  // A little hack to remove the last bracket
-  props[strlen (props) - 2] = '\0';
-
-  list = self->list;
-  acc = g_strdup ("");
-  while (list) {
-    separator = list->next ? "," : "";
-    node =
-        g_strdup_printf ("%s{\n    \"name\" : \"%s\"\n  }%s", acc,
-        GSTD_OBJECT_NAME (list->data), separator);
-    g_free (acc);
-    acc = node;
-    list = list->next;
+  if (page->skipped < page->offset) {
+    page->skipped++;
+    return TRUE;
   }
 
-  *outstring = g_strdup_printf ("%s,\n  \"nodes\" : [%s]\n}", props, acc);
-  g_free (props);
-  g_free (acc);
+  gstd_iformatter_begin_object (page->formatter);
+  gstd_iformatter_set_member_name (page->formatter, "name");
+  gstd_iformatter_set_string_value (page->formatter, name);
+  gstd_iformatter_end_object (page->formatter);
+  page->listed++;
+
+  return TRUE;
+}
+
+GstdReturnCode
+gstd_list_to_string_range (GstdList * self, guint offset, guint limit,
+    const gchar * prefix, gchar ** outstring)
+{
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (GSTD_IS_LIST (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (outstring, GSTD_NULL_ARGUMENT);
+  g_warn_if_fail (!*outstring);
+
+  gstd_object_formatter_acquire (GSTD_OBJECT (self));
+  ret = gstd_list_format_range (self, offset, limit, prefix, outstring);
+  gstd_object_formatter_release (GSTD_OBJECT (self), GSTD_EOK == ret);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_list_format_range (GstdList * self, guint offset, guint limit,
+    const gchar * prefix, gchar ** outstring)
+{
+  GstdListPage page = { NULL, offset, limit, prefix, 0, 0 };
+
+  page.formatter = GSTD_OBJECT (self)->formatter;
+
+  gstd_iformatter_begin_object (page.formatter);
+  gstd_object_format_properties (GSTD_OBJECT (self));
+
+  gstd_iformatter_set_member_name (page.formatter, "nodes");
+  gstd_iformatter_begin_array (page.formatter);
+  GSTD_LIST_GET_CLASS (self)->foreach_name (self, gstd_list_format_node,
+      &page);
+  gstd_iformatter_end_array (page.formatter);
+
+  gstd_iformatter_end_object (page.formatter);
+
+  gstd_iformatter_generate (page.formatter, outstring);
 
   return GSTD_EOK;
 }
 
+static void
+gstd_list_foreach_name_default (GstdList * self, GstdListNameFunc func,
+    gpointer user_data)
+{
+  GList *list;
+
+  for (list = self->list->head; list; list = list->next) {
+    if (!func (GSTD_OBJECT_NAME (list->data), user_data)) {
+      break;
+    }
+  }
+}
+
 GstdObject *
-gstd_list_find_child (GstdList *self, const gchar * name)
+gstd_list_find_child (GstdList * self, const gchar * name)
+{
+  g_return_val_if_fail (GSTD_IS_LIST (self), NULL);
+  g_return_val_if_fail (name, NULL);
+
+  return GSTD_LIST_GET_CLASS (self)->find_child (self, name);
+}
+
+static GstdObject *
+gstd_list_find_child_default (GstdList *self, const gchar * name)
 {
     GList * result;
     GstdObject * child;
@@ -327,11 +402,11 @@ gstd_list_find_child (GstdList *self, const gchar * name)
     g_return_val_if_fail (self, NULL);
     g_return_val_if_fail (name, NULL);
 
-    result = g_list_find_custom (self->list, name, gstd_list_find_node);
+    result = g_hash_table_lookup (self->index, name);
 
 
     if (result) {
-	child = GSTD_OBJECT(result->data);
+	child = GSTD_OBJECT(g_object_ref (result->data));
     } else {
 	child = NULL;
     }
@@ -348,12 +423,14 @@ gstd_list_append_child (GstdList * self, GstdObject * child)
   g_return_val_if_fail (child, GSTD_NULL_ARGUMENT);
 
   /* Test if the resource to create already exists */
-  found = g_list_find_custom (self->list, GSTD_OBJECT_NAME(child), gstd_list_find_node);
+  found = g_hash_table_lookup (self->index, GSTD_OBJECT_NAME(child));
   if (found)
     goto exists;
 
-  self->list = g_list_append (self->list, child);
-  self->count = g_list_length (self->list);
+  g_queue_push_tail (self->list, child);
+  g_hash_table_insert (self->index, g_strdup (GSTD_OBJECT_NAME(child)),
+      g_queue_peek_tail_link (self->list));
+  self->count = g_queue_get_length (self->list);
   GST_INFO_OBJECT (self, "Appended %s to %s list", GSTD_OBJECT_NAME (child),
       GSTD_OBJECT_NAME (self));
 
@@ -366,3 +443,11 @@ exists:
     return FALSE;
   }
 }
+
+guint
+gstd_list_get_generation (GstdList * self)
+{
+  g_return_val_if_fail (GSTD_IS_LIST (self), 0);
+
+  return g_atomic_int_get (&self->generation);
+}
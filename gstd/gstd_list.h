@@ -57,18 +57,75 @@ struct _GstdList
 
   GParamFlags flags;
 
-  GList *list;
+  /* Children in insertion order, indexed by name */
+  GQueue *list;
+  GHashTable *index;
+
+  /* Bumped whenever a child is deleted, see gstd_list_get_generation */
+  guint generation;
 };
 
+/**
+ * GstdListNameFunc:
+ * @name: The name of a node
+ * @user_data: The data passed along with the function
+ *
+ * Returns: FALSE to stop iterating
+ */
+typedef gboolean (*GstdListNameFunc) (const gchar * name, gpointer user_data);
+
 struct _GstdListClass
 {
   GstdObjectClass parent_class;
+
+  /*
+   * Lists that create their nodes on demand override these, so nodes
+   * that were never accessed are still found and listed. find_child
+   * returns a new reference, such lists may drop the node meanwhile
+   */
+  GstdObject *(*find_child) (GstdList * self, const gchar * name);
+  void (*foreach_name) (GstdList * self, GstdListNameFunc func,
+      gpointer user_data);
 };
 
 GType gstd_list_get_type ();
 
+/**
+ * gstd_list_find_child:
+ * @self: The list to search
+ * @name: The name of the child
+ *
+ * Returns: (transfer full) (nullable): A new reference to the child, or
+ * NULL if there is none with that name
+ */
 GstdObject * gstd_list_find_child (GstdList *self, const gchar * name);
 gboolean gstd_list_append_child (GstdList *, GstdObject *child);
 
+/**
+ * gstd_list_to_string_range:
+ * @self: The list to serialize
+ * @offset: Number of matching nodes to skip
+ * @limit: Maximum number of nodes to serialize, 0 for all of them
+ * @prefix: (nullable): Only serialize nodes whose name starts with it
+ * @outstring: Placeholder for the serialized list, must be NULL. Free
+ * with g_free after usage
+ *
+ * Serializes a page of the list in insertion order. The count property
+ * still reports every node in the list.
+ *
+ * Returns: A GstdReturnCode with the execution status
+ */
+GstdReturnCode gstd_list_to_string_range (GstdList * self, guint offset,
+    guint limit, const gchar * prefix, gchar ** outstring);
+
+/**
+ * gstd_list_get_generation:
+ * @self: The list to query
+ *
+ * Returns: A counter that changes every time a node is deleted from
+ * this list, so nodes resolved through it before may be gone
+ */
+guint gstd_list_get_generation (GstdList * self);
+
 G_END_DECLS
 #endif // __GSTD_LIST_H__
@@ -34,6 +34,7 @@
 #include "gstd_no_deleter.h"
 
 #include "gstd_json_builder.h"
+#include "gstd_cbor_writer.h"
 
 enum
 {
@@ -47,8 +48,31 @@ GST_DEBUG_CATEGORY_STATIC (gstd_object_debug);
 
 #define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
 
+/* Idle formatters kept by each thread */
+#define GSTD_OBJECT_FORMATTER_POOL_SIZE 4
+
 G_DEFINE_TYPE (GstdObject, gstd_object, G_TYPE_OBJECT);
 
+/* Strategies are stateless, every object shares one instance per type */
+static GHashTable *strategies = NULL;
+G_LOCK_DEFINE_STATIC (strategies);
+
+/* Type of the formatters lent to objects */
+static GType formatter_type = G_TYPE_INVALID;
+
+/* Set on threads serializing without whitespace */
+static GPrivate compact_key = G_PRIVATE_INIT (NULL);
+
+/* Set on threads serializing to CBOR */
+static GPrivate binary_key = G_PRIVATE_INIT (NULL);
+
+/* The property members left out by each thread, none by default */
+static GPrivate skipped_fields_key = G_PRIVATE_INIT (NULL);
+
+static void gstd_object_formatter_pool_free (gpointer data);
+static GPrivate formatter_pool =
+G_PRIVATE_INIT (gstd_object_formatter_pool_free);
+
 /* VTable */
 static void
 gstd_object_set_property (GObject *, guint, const GValue *, GParamSpec *);
@@ -65,6 +89,7 @@ static GstdReturnCode
 gstd_object_delete_default (GstdObject * object, const gchar * name);
 static GstdReturnCode
 gstd_object_to_string_default (GstdObject * object, gchar ** outstring);
+static gboolean gstd_object_is_cacheable_default (GstdObject * object);
 void gstd_object_finalize( GObject *object);
 
 GType
@@ -111,6 +136,7 @@ gstd_object_class_init (GstdObjectClass * klass)
   klass->update = gstd_object_update_default;
   klass->delete = gstd_object_delete_default;
   klass->to_string = gstd_object_to_string_default;
+  klass->is_cacheable = gstd_object_is_cacheable_default;
 
   /* Initialize debug category with nice colors */
   debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
@@ -124,11 +150,14 @@ gstd_object_init (GstdObject * self)
   GST_DEBUG_OBJECT (self, "Initializing gstd object");
 
   self->name = g_strdup (GSTD_OBJECT_DEFAULT_NAME);
-  self->creator = g_object_new (GSTD_TYPE_NO_CREATOR, NULL);
-  self->reader = g_object_new (GSTD_TYPE_NO_READER, NULL);
-  self->updater = g_object_new (GSTD_TYPE_NO_UPDATER, NULL);
-  self->deleter = g_object_new (GSTD_TYPE_NO_DELETER, NULL);
-  self->formatter = g_object_new (GSTD_TYPE_JSON_BUILDER, NULL);
+  self->creator = gstd_object_get_strategy (GSTD_TYPE_NO_CREATOR);
+  self->reader = gstd_object_get_strategy (GSTD_TYPE_NO_READER);
+  self->updater = gstd_object_get_strategy (GSTD_TYPE_NO_UPDATER);
+  self->deleter = gstd_object_get_strategy (GSTD_TYPE_NO_DELETER);
+
+  /* Borrowed from the pool only while serializing */
+  self->formatter = NULL;
+  g_mutex_init (&self->codelock);
 }
 
 void gstd_object_finalize( GObject *object)
@@ -136,8 +165,7 @@ void gstd_object_finalize( GObject *object)
   GstdObject *self = GSTD_OBJECT(object);
   GST_DEBUG_OBJECT (self, "finalize");
 
-  /* Free formatter */
-  g_object_unref (self->formatter);
+  g_mutex_clear (&self->codelock);
 
   G_OBJECT_CLASS (gstd_object_parent_class)->finalize (object);
 }
@@ -262,76 +290,96 @@ gstd_object_delete_default (GstdObject * object, const gchar * name)
 static GstdReturnCode
 gstd_object_to_string_default (GstdObject * self, gchar ** outstring)
 {
-  GParamSpec **properties;
-  GValue value = G_VALUE_INIT;
-  GValue bool_value = G_VALUE_INIT;
-  GValue flags = G_VALUE_INIT;
-  gchar *sflags;
-  guint n, i;
-  const gchar *typename;
-  
   gstd_iformatter_begin_object (self->formatter);
+  gstd_object_format_properties (self);
+  gstd_iformatter_end_object (self->formatter);
+
+  gstd_iformatter_generate (self->formatter, outstring);
+
+  return GSTD_EOK;
+}
+
+void
+gstd_object_format_properties (GstdObject * self)
+{
+  const GstdSchema *schema;
+  GParamSpec *pspec;
+  GValue value = G_VALUE_INIT;
+  guint fields;
+  guint i;
+
+  g_return_if_fail (GSTD_IS_OBJECT (self));
+
+  fields = gstd_object_get_fields ();
+  schema = gstd_schema_get (G_OBJECT_TYPE (self));
+
   gstd_iformatter_set_member_name (self->formatter,"properties");
   gstd_iformatter_begin_array (self->formatter);
   
-  properties = g_object_class_list_properties(G_OBJECT_GET_CLASS(self), &n);
-  for (i=0; i<n; i++) {
+  for (i=0; i<schema->n_properties; i++) {
+    pspec = schema->properties[i].pspec;
+
     /* Describe each parameter using a structure */
     gstd_iformatter_begin_object (self->formatter);
 
-    gstd_iformatter_set_member_name (self->formatter,"name");
-
-    gstd_iformatter_set_string_value (self->formatter, properties[i]->name);
+    if (fields & GSTD_FIELD_NAME) {
+      gstd_iformatter_set_member_name (self->formatter,"name");
+      gstd_iformatter_set_string_value (self->formatter, pspec->name);
+    }
 
-    typename = g_type_name(properties[i]->value_type);
+    if (fields & GSTD_FIELD_VALUE) {
+      g_value_init (&value, pspec->value_type);
+      g_object_get_property(G_OBJECT(self), pspec->name, &value);
 
-    g_value_init (&value, properties[i]->value_type);
-    g_object_get_property(G_OBJECT(self), properties[i]->name, &value);
+      gstd_iformatter_set_member_name (self->formatter,"value");
+      gstd_iformatter_set_value (self->formatter, &value);
+      g_value_unset(&value);
+    }
 
-    gstd_iformatter_set_member_name (self->formatter,"value");
-    gstd_iformatter_set_value (self->formatter, &value);
+    gstd_object_format_param_spec (self->formatter, &schema->properties[i]);
 
-    gstd_iformatter_set_member_name (self->formatter, "param_spec");
-    /* Describe the parameter specs using a structure */
-    gstd_iformatter_begin_object (self->formatter);
+    /* Close parameter structure */
+    gstd_iformatter_end_object (self->formatter);
+  }
 
-    g_value_unset(&value);
+  gstd_iformatter_end_array (self->formatter); 
+}
 
-    g_value_init (&flags, GSTD_TYPE_PARAM_FLAGS);
-    g_value_set_flags (&flags, properties[i]->flags);
-    sflags = g_strdup_value_contents(&flags);
-    g_value_unset(&flags);
+void
+gstd_object_format_param_spec (GstdIFormatter * formatter,
+    const GstdSchemaProperty * property)
+{
+  GValue bool_value = G_VALUE_INIT;
 
-    gstd_iformatter_set_member_name (self->formatter, "blurb");
-    gstd_iformatter_set_string_value (self->formatter,properties[i]->_blurb);
+  g_return_if_fail (GSTD_IS_IFORMATTER (formatter));
+  g_return_if_fail (property);
 
-    gstd_iformatter_set_member_name (self->formatter, "type");
-    gstd_iformatter_set_string_value (self->formatter,typename);
+  if (!(gstd_object_get_fields () & GSTD_FIELD_PARAM_SPEC)) {
+    return;
+  }
 
-    gstd_iformatter_set_member_name (self->formatter, "access");
-    gstd_iformatter_set_string_value (self->formatter,sflags);
+  gstd_iformatter_set_member_name (formatter, "param_spec");
+  /* Describe the parameter specs using a structure */
+  gstd_iformatter_begin_object (formatter);
 
-    gstd_iformatter_set_member_name (self->formatter, "construct");
+  gstd_iformatter_set_member_name (formatter, "blurb");
+  gstd_iformatter_set_string_value (formatter, property->blurb);
 
-    g_value_init (&bool_value, G_TYPE_BOOLEAN);
-    g_value_set_boolean(&bool_value,GSTD_PARAM_IS_DELETE(properties[i]->flags));
-    gstd_iformatter_set_value (self->formatter, &bool_value);
-    g_value_unset(&bool_value);
-    /* Close parameter specs structure */
-    gstd_iformatter_end_object (self->formatter);
+  gstd_iformatter_set_member_name (formatter, "type");
+  gstd_iformatter_set_string_value (formatter, property->type_name);
 
-    g_free (sflags);
-    /* Close parameter structure */
-    gstd_iformatter_end_object (self->formatter);
-  }
-  g_free (properties);
+  gstd_iformatter_set_member_name (formatter, "access");
+  gstd_iformatter_set_string_value (formatter, property->access);
 
-  gstd_iformatter_end_array (self->formatter); 
-  gstd_iformatter_end_object (self->formatter);
+  gstd_iformatter_set_member_name (formatter, "construct");
 
-  gstd_iformatter_generate (self->formatter, outstring);
+  g_value_init (&bool_value, G_TYPE_BOOLEAN);
+  g_value_set_boolean (&bool_value, property->construct);
+  gstd_iformatter_set_value (formatter, &bool_value);
+  g_value_unset(&bool_value);
 
-  return GSTD_EOK;
+  /* Close parameter specs structure */
+  gstd_iformatter_end_object (formatter);
 }
 
 GstdReturnCode
@@ -377,10 +425,162 @@ gstd_object_delete (GstdObject * object, const gchar * name)
 GstdReturnCode
 gstd_object_to_string (GstdObject * object, gchar ** outstring)
 {
+  GstdReturnCode ret;
+
   g_return_val_if_fail (GSTD_IS_OBJECT (object), GSTD_NULL_ARGUMENT);
   g_warn_if_fail (!*outstring);
 
-  return GSTD_OBJECT_GET_CLASS (object)->to_string (object, outstring);
+  gstd_object_formatter_acquire (object);
+  ret = GSTD_OBJECT_GET_CLASS (object)->to_string (object, outstring);
+  gstd_object_formatter_release (object, GSTD_EOK == ret);
+
+  return ret;
+}
+
+/* Most nodes are members of their parent and live as long as it does */
+static gboolean
+gstd_object_is_cacheable_default (GstdObject * object)
+{
+  return TRUE;
+}
+
+gboolean
+gstd_object_is_cacheable (GstdObject * object)
+{
+  g_return_val_if_fail (GSTD_IS_OBJECT (object), FALSE);
+
+  return GSTD_OBJECT_GET_CLASS (object)->is_cacheable (object);
+}
+
+static void
+gstd_object_formatter_pool_free (gpointer data)
+{
+  g_slist_free_full (data, g_object_unref);
+}
+
+void
+gstd_object_formatter_acquire (GstdObject * self)
+{
+  GSList *pool;
+  GSList *link;
+  GType type;
+
+  g_return_if_fail (GSTD_IS_OBJECT (self));
+
+  /* Serializing the same object from several threads would mix them */
+  g_mutex_lock (&self->codelock);
+
+  if (G_TYPE_INVALID == formatter_type) {
+    formatter_type = GSTD_TYPE_JSON_BUILDER;
+  }
+  type = gstd_object_get_binary () ? GSTD_TYPE_CBOR_WRITER : formatter_type;
+
+  /* Threads may serve connections using different formats */
+  pool = g_private_get (&formatter_pool);
+  for (link = pool; link; link = link->next) {
+    if (G_OBJECT_TYPE (link->data) == type) {
+      break;
+    }
+  }
+
+  if (link) {
+    self->formatter = link->data;
+    g_private_set (&formatter_pool, g_slist_delete_link (pool, link));
+  } else {
+    self->formatter = g_object_new (type, NULL);
+  }
+
+  gstd_iformatter_set_pretty (self->formatter, gstd_object_get_pretty ());
+}
+
+void
+gstd_object_formatter_release (GstdObject * self, gboolean reuse)
+{
+  GSList *pool;
+
+  g_return_if_fail (GSTD_IS_OBJECT (self));
+  g_return_if_fail (self->formatter);
+
+  pool = g_private_get (&formatter_pool);
+
+  /* A failed serialization may leave the formatter half built */
+  if (reuse && g_slist_length (pool) < GSTD_OBJECT_FORMATTER_POOL_SIZE) {
+    g_private_set (&formatter_pool, g_slist_prepend (pool, self->formatter));
+  } else {
+    g_object_unref (self->formatter);
+  }
+  self->formatter = NULL;
+
+  g_mutex_unlock (&self->codelock);
+}
+
+void
+gstd_object_set_pretty (gboolean pretty)
+{
+  g_private_set (&compact_key, GINT_TO_POINTER (!pretty));
+}
+
+gboolean
+gstd_object_get_pretty (void)
+{
+  return !g_private_get (&compact_key);
+}
+
+void
+gstd_object_set_binary (gboolean binary)
+{
+  g_private_set (&binary_key, GINT_TO_POINTER (binary));
+}
+
+gboolean
+gstd_object_get_binary (void)
+{
+  return GPOINTER_TO_INT (g_private_get (&binary_key));
+}
+
+void
+gstd_object_set_fields (guint fields)
+{
+  g_private_set (&skipped_fields_key,
+      GUINT_TO_POINTER (~fields & GSTD_FIELDS_ALL));
+}
+
+guint
+gstd_object_get_fields (void)
+{
+  return ~GPOINTER_TO_UINT (g_private_get (&skipped_fields_key)) &
+      GSTD_FIELDS_ALL;
+}
+
+void
+gstd_object_set_formatter_type (GType type)
+{
+  g_return_if_fail (g_type_is_a (type, GSTD_TYPE_IFORMATTER));
+
+  formatter_type = type;
+}
+
+gpointer
+gstd_object_get_strategy (GType type)
+{
+  GObject *strategy;
+
+  G_LOCK (strategies);
+
+  if (!strategies) {
+    strategies = g_hash_table_new_full (NULL, NULL, NULL, g_object_unref);
+  }
+
+  strategy = g_hash_table_lookup (strategies, GSIZE_TO_POINTER (type));
+  if (!strategy) {
+    strategy = g_object_new (type, NULL);
+    g_hash_table_insert (strategies, GSIZE_TO_POINTER (type), strategy);
+  }
+  g_object_ref (strategy);
+
+  G_UNLOCK (strategies);
+
+  return strategy;
 }
 
 void
@@ -27,6 +27,7 @@
 #include "gstd_iupdater.h"
 #include "gstd_ideleter.h"
 #include "gstd_iformatter.h"
+#include "gstd_schema.h"
 
 typedef struct _GstdIFormatter GstdIFormatter;
 
@@ -56,7 +57,7 @@ struct _GstdObject
   gchar *name;
 
   /**
-   * A protection for the object's lock
+   * A protection for the object's lock, held while serializing
    */
   GMutex codelock;
 
@@ -71,6 +72,9 @@ struct _GstdObject
   GstdIUpdater *updater;
   GstdIDeleter *deleter;
 
+  /**
+   * Only set while the object is being serialized
+   */
   GstdIFormatter * formatter;
 };
 
@@ -89,6 +93,10 @@ struct _GstdObjectClass
     GstdReturnCode (*delete) (GstdObject * object, const gchar * name);
 
     GstdReturnCode (*to_string) (GstdObject * object, gchar ** outstring);
+
+  /* Whether the tree keeps the node, so URIs resolving to it may be
+   * cached. Nodes built for a single read must return FALSE. */
+    gboolean (*is_cacheable) (GstdObject * object);
 };
 
 GType gstd_object_get_type (void);
@@ -103,6 +111,17 @@ GType gstd_object_get_type (void);
 #define GSTD_TYPE_PARAM_FLAGS (gstd_object_flags_get_type ())
 GType gstd_object_flags_get_type (void);
 
+/* Members of a property description, see gstd_object_set_fields() */
+typedef enum
+{
+  GSTD_FIELD_NAME = (1 << 0),
+  GSTD_FIELD_VALUE = (1 << 1),
+  GSTD_FIELD_PARAM_SPEC = (1 << 2),
+} GstdField;
+
+#define GSTD_FIELDS_ALL \
+  (GSTD_FIELD_NAME | GSTD_FIELD_VALUE | GSTD_FIELD_PARAM_SPEC)
+
 #define GSTD_PARAM_IS_CREATE(p) (p & GSTD_PARAM_CREATE)
 #define GSTD_PARAM_IS_READ(p)   (p & GSTD_PARAM_READ)
 #define GSTD_PARAM_IS_UPDATE(p) (p & GSTD_PARAM_UPDATE)
@@ -118,6 +137,105 @@ gstd_object_update (GstdObject * object, const gchar *value);
 GstdReturnCode gstd_object_delete (GstdObject * object, const gchar * name);
 GstdReturnCode gstd_object_to_string (GstdObject * object, gchar ** outstring);
 
+/**
+ * gstd_object_is_cacheable:
+ * @object: A node returned by a read
+ *
+ * Returns: TRUE if the node is kept by the tree and may be looked up
+ * again by URI, FALSE if it was built for a single read
+ */
+gboolean gstd_object_is_cacheable (GstdObject * object);
+
+/**
+ * gstd_object_format_properties:
+ * @object: The object to describe
+ *
+ * Adds the "properties" member describing every property of @object to
+ * the object currently open in its formatter. Lets subclasses extend the
+ * default serialization instead of patching its output.
+ */
+void gstd_object_format_properties (GstdObject * object);
+
+/**
+ * gstd_object_format_param_spec:
+ * @formatter: The formatter describing the property
+ * @property: The cached description of the property, see gstd_schema_get()
+ *
+ * Adds the "param_spec" member describing @property to the object
+ * currently open in @formatter, unless the calling thread left it out
+ * with gstd_object_set_fields().
+ */
+void gstd_object_format_param_spec (GstdIFormatter * formatter,
+    const GstdSchemaProperty * property);
+
+/**
+ * gstd_object_formatter_acquire:
+ * @object: The object about to be serialized
+ *
+ * Lends @object a formatter from a pool kept by the calling thread. Done
+ * by gstd_object_to_string(), only needed by other functions serializing
+ * an object.
+ */
+void gstd_object_formatter_acquire (GstdObject * object);
+
+/**
+ * gstd_object_formatter_release:
+ * @object: The object that was serialized
+ * @reuse: FALSE if the serialization was interrupted
+ *
+ * Gives the formatter lent by gstd_object_formatter_acquire() back.
+ */
+void gstd_object_formatter_release (GstdObject * object, gboolean reuse);
+
+/**
+ * gstd_object_set_pretty:
+ * @pretty: FALSE leaves out every optional whitespace
+ *
+ * Selects the layout of the objects serialized by the calling thread
+ * from then on. Threads start pretty printing.
+ */
+void gstd_object_set_pretty (gboolean pretty);
+gboolean gstd_object_get_pretty (void);
+
+/**
+ * gstd_object_set_binary:
+ * @binary: TRUE serializes to CBOR, see #GstdCborWriter
+ *
+ * Like gstd_object_set_pretty(), for the calling thread. Binary outputs
+ * may contain NUL characters and carry their size instead.
+ */
+void gstd_object_set_binary (gboolean binary);
+gboolean gstd_object_get_binary (void);
+
+/**
+ * gstd_object_set_fields:
+ * @fields: The #GstdField members to describe properties with
+ *
+ * Like gstd_object_set_pretty(), for the calling thread. Reads polling
+ * values only skip the property metadata with %GSTD_FIELD_VALUE. Threads
+ * start with %GSTD_FIELDS_ALL.
+ */
+void gstd_object_set_fields (guint fields);
+guint gstd_object_get_fields (void);
+
+/**
+ * gstd_object_set_formatter_type:
+ * @type: A #GstdIFormatter implementation, #GstdJsonBuilder by default
+ *
+ * Selects the formatter lent to objects from then on. Meant to be
+ * called on startup.
+ */
+void gstd_object_set_formatter_type (GType type);
+
+/**
+ * gstd_object_get_strategy:
+ * @type: A creator, reader, updater or deleter type without state
+ *
+ * Returns: (transfer full): The instance of @type shared by every object,
+ * to be given to gstd_object_set_creator() and friends
+ */
+gpointer gstd_object_get_strategy (GType type);
+
 void gstd_object_set_creator (GstdObject * self, GstdICreator * creator);
 void gstd_object_set_reader (GstdObject * self, GstdIReader * reader);
 void gstd_object_set_updater (GstdObject * self, GstdIUpdater * updater);
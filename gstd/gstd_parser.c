@@ -0,0 +1,2158 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <gst/gst.h>
+#include <json-glib/json-glib.h>
+#include <gst/controller/gstinterpolationcontrolsource.h>
+#include <gst/controller/gstdirectcontrolbinding.h>
+
+#include "gstd_parser.h"
+#include "gstd_element.h"
+#include "gstd_pipeline.h"
+#include "gstd_pipeline_bus.h"
+#include "gstd_event_handler.h"
+#include "gstd_property.h"
+#include "gstd_list.h"
+#include "gstd_bus_msg.h"
+#include "gstd_msg_type.h"
+#include "gstd_cbor_writer.h"
+#include "gstd_schema.h"
+
+/* Gstd Parser debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_parser_debug);
+#define GST_CAT_DEFAULT gstd_parser_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+#define check_argument(arg, code) \
+    if (NULL == (arg)) return (code)
+
+/* Where raw commands create batches */
+#define GSTD_PARSER_BATCH_URI "/batch"
+
+typedef GstdReturnCode GstdFunc (GstdSession *, gchar *, gchar *, gchar **);
+typedef void GstdAsyncFunc (GstdSession *, gchar *, gchar *, GCancellable *,
+    GstdParserReadyFunc, gpointer);
+typedef struct _GstdCmd
+{
+  gchar *cmd;
+  GstdFunc *callback;
+  /* Commands that may wait on something provide an asynchronous
+   * variant as well, so they don't pin the calling thread */
+  GstdAsyncFunc *async_callback;
+} GstdCmd;
+
+/* The caller of an asynchronous command, to be notified on completion */
+typedef struct _GstdParserAsync
+{
+  GstdParserReadyFunc func;
+  gpointer user_data;
+  /* The format requested by the caller's thread */
+  gboolean pretty;
+  gboolean binary;
+} GstdParserAsync;
+
+/* An operation on an already resolved node */
+typedef GstdReturnCode GstdAction (GstdSession *, GstdObject *,
+    const gchar *, gchar **);
+
+static void gstd_parser_init (void);
+static void gstd_parser_split (gchar * args, gchar ** tokens, guint max);
+static GstdCmd *gstd_parser_route (gchar * line, gchar ** action,
+    gchar ** args);
+static GstdReturnCode gstd_parser_lookup_valist (GstdSession * session,
+    GstdObject ** node, va_list names);
+static GstdReturnCode gstd_parser_lookup (GstdSession * session,
+    GstdObject ** node, ...) G_GNUC_NULL_TERMINATED;
+static GstdReturnCode gstd_parser_apply (GstdSession * session,
+    GstdAction * action, const gchar * args, gchar ** response, ...)
+    G_GNUC_NULL_TERMINATED;
+static GstdReturnCode gstd_parser_parse_raw_cmd (GstdSession * session,
+    gchar * action, gchar * args, gchar ** response);
+static GstdReturnCode gstd_parser_create_object (GstdSession * session,
+    GstdObject * obj, const gchar * name, const gchar * description,
+    gchar ** response);
+static GstdReturnCode gstd_parser_create (GstdSession * session,
+    GstdObject * obj, const gchar * args, gchar ** response);
+static GstdReturnCode gstd_parser_read (GstdSession * session,
+    GstdObject * obj, const gchar * args, gchar ** reponse);
+static GstdReturnCode gstd_parser_read_list (GstdSession * session,
+    GstdObject * obj, const gchar * args, gchar ** response);
+static GstdReturnCode gstd_parser_update (GstdSession * session,
+    GstdObject * obj, const gchar * args, gchar ** response);
+static GstdReturnCode gstd_parser_delete (GstdSession * session,
+    GstdObject * obj, const gchar * args, gchar ** response);
+static GstdReturnCode gstd_parser_event_create (GstdSession * session,
+    const gchar * pipeline, const gchar * event, const gchar * description,
+    gchar ** response);
+static GstdReturnCode gstd_parser_pipeline_create (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_pipeline_delete (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_pipeline_play (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_pipeline_pause (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_pipeline_snapshot (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_pipeline_stop (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_set (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_get (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_set_many (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_get_many (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_element_ramp (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_list_pipelines (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_list_elements (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_list_properties (GstdSession *, gchar *,
+    gchar *, gchar **);
+static GstdReturnCode gstd_parser_bus_read (GstdSession*, gchar *, gchar *,
+    gchar **);
+static void gstd_parser_bus_read_async (GstdSession *, gchar *, gchar *,
+    GCancellable *, GstdParserReadyFunc, gpointer);
+static void gstd_parser_bus_read_done (GstdPipelineBus * bus,
+    GstMessage * message, gpointer user_data);
+static GstdReturnCode gstd_parser_bus_filter (GstdSession*, gchar *, gchar *,
+    gchar **);
+static GstdReturnCode gstd_parser_bus_timeout (GstdSession*, gchar *, gchar *,
+    gchar **);
+static GstdReturnCode gstd_parser_event_eos (GstdSession*, gchar *, gchar *,
+    gchar **);
+static GstdReturnCode gstd_parser_event_seek (GstdSession*, gchar *, gchar *,
+    gchar **);
+static GstdReturnCode gstd_parser_event_flush_start (GstdSession*, gchar *, gchar *,
+    gchar **);
+static GstdReturnCode gstd_parser_event_flush_stop (GstdSession*, gchar *, gchar *,
+    gchar **);
+
+static GstdReturnCode gstd_parser_debug_enable (GstdSession*, gchar *, gchar *,
+    gchar **);
+static GstdReturnCode gstd_parser_debug_threshold (GstdSession*, gchar *, gchar *,
+    gchar **);
+static GstdReturnCode gstd_parser_debug_color (GstdSession*, gchar *, gchar *,
+    gchar **);
+
+static GstdReturnCode gstd_parser_batch (GstdSession *, gchar *, gchar *,
+    gchar **);
+static void gstd_parser_journal_record (GQueue * journal,
+    GstdProperty * property);
+static void gstd_parser_journal_save (GQueue * journal, GObject * target,
+    GParamSpec * pspec);
+static void gstd_parser_journal_rollback (GQueue * journal);
+static void gstd_parser_journal_free (GQueue * journal);
+static gchar *gstd_parser_envelope_binary (GstdReturnCode ret,
+    const gchar * output, const gchar * id, gint64 dropped);
+
+static GstdCmd cmds[] = {
+  {"create", gstd_parser_parse_raw_cmd},
+  {"read", gstd_parser_parse_raw_cmd},
+  {"update", gstd_parser_parse_raw_cmd},
+  {"delete", gstd_parser_parse_raw_cmd},
+
+  {"pipeline_create", gstd_parser_pipeline_create},
+  {"pipeline_delete", gstd_parser_pipeline_delete},
+  {"pipeline_play", gstd_parser_pipeline_play},
+  {"pipeline_pause", gstd_parser_pipeline_pause},
+  {"pipeline_stop", gstd_parser_pipeline_stop},
+  {"pipeline_snapshot", gstd_parser_pipeline_snapshot},
+
+  {"element_set", gstd_parser_element_set},
+  {"element_get", gstd_parser_element_get},
+  {"element_set_many", gstd_parser_element_set_many},
+  {"element_get_many", gstd_parser_element_get_many},
+  {"element_ramp", gstd_parser_element_ramp},
+
+  {"list_pipelines", gstd_parser_list_pipelines},
+  {"list_elements", gstd_parser_list_elements},
+  {"list_properties", gstd_parser_list_properties},
+
+  {"bus_read", gstd_parser_bus_read, gstd_parser_bus_read_async},
+  {"bus_filter", gstd_parser_bus_filter},
+  {"bus_timeout", gstd_parser_bus_timeout},
+
+  {"event_eos", gstd_parser_event_eos},
+  {"event_seek", gstd_parser_event_seek},
+  {"event_flush_start", gstd_parser_event_flush_start},
+  {"event_flush_stop", gstd_parser_event_flush_stop},
+
+  {"debug_enable", gstd_parser_debug_enable},
+  {"debug_threshold", gstd_parser_debug_threshold},
+  {"debug_color", gstd_parser_debug_color},
+
+  {"batch", gstd_parser_batch},
+
+  {NULL}
+};
+
+/* Maps each verb to its entry in cmds, built once on first use */
+static GHashTable *router = NULL;
+
+/* A property value to restore if an atomic batch fails */
+typedef struct _GstdParserUndo
+{
+  GObject *target;
+  const gchar *name;
+  GValue value;
+} GstdParserUndo;
+
+/* The undo records of the atomic batch running in the current thread,
+ * if any. Every property write goes through gstd_parser_update so this
+ * is the single place where they need to be journaled */
+static GPrivate journal_key = G_PRIVATE_INIT (NULL);
+
+static void
+gstd_parser_init (void)
+{
+  static gsize initialized = 0;
+  guint debug_color;
+  GstdCmd *cb;
+
+  if (g_once_init_enter (&initialized)) {
+    /* Initialize debug category with nice colors */
+    debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+    GST_DEBUG_CATEGORY_INIT (gstd_parser_debug, "gstdparser", debug_color,
+        "Gstd Parser category");
+
+    /* Verbs are matched case insensitively, they are lowered before
+     * looking them up */
+    router = g_hash_table_new (g_str_hash, g_str_equal);
+    for (cb = cmds; cb->cmd; cb++) {
+      g_hash_table_insert (router, cb->cmd, cb);
+    }
+
+    g_once_init_leave (&initialized, 1);
+  }
+}
+
+/* Splits args in place at single spaces, the last token keeps the rest
+ * of the line. Unused tokens are set to NULL */
+static void
+gstd_parser_split (gchar * args, gchar ** tokens, guint max)
+{
+  guint i;
+
+  for (i = 0; i < max; i++) {
+    tokens[i] = NULL;
+  }
+
+  if (NULL == args || '\0' == args[0]) {
+    return;
+  }
+
+  for (i = 0; i < max - 1; i++) {
+    tokens[i] = args;
+    args = strchr (args, ' ');
+    if (NULL == args) {
+      return;
+    }
+    *args++ = '\0';
+  }
+  tokens[i] = args;
+}
+
+/* Walks the tree from the session through a NULL terminated list of
+ * child names, same as gstd_get_by_uri without building a URI first */
+static GstdReturnCode
+gstd_parser_lookup_valist (GstdSession * session, GstdObject ** node,
+    va_list names)
+{
+  GstdObject *parent, *child;
+  const gchar *name;
+
+  parent = g_object_ref (GSTD_OBJECT (session));
+
+  while ((name = va_arg (names, const gchar *))) {
+    if (gstd_object_read (parent, name, &child)) {
+      GST_ERROR_OBJECT (session, "Invalid node %s", name);
+      g_object_unref (parent);
+      *node = NULL;
+      return GSTD_BAD_COMMAND;
+    }
+
+    g_object_unref (parent);
+    parent = child;
+  }
+
+  *node = parent;
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_parser_lookup (GstdSession * session, GstdObject ** node, ...)
+{
+  GstdReturnCode ret;
+  va_list names;
+
+  va_start (names, node);
+  ret = gstd_parser_lookup_valist (session, node, names);
+  va_end (names);
+
+  return ret;
+}
+
+/* Resolves the node at the given path and runs action on it */
+static GstdReturnCode
+gstd_parser_apply (GstdSession * session, GstdAction * action,
+    const gchar * args, gchar ** response, ...)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+  va_list names;
+
+  va_start (names, response);
+  ret = gstd_parser_lookup_valist (session, &node, names);
+  va_end (names);
+
+  /* Bus reads that time out resolve to no node at all */
+  if (ret || NULL == node) {
+    return ret;
+  }
+
+  ret = action (session, node, args, response);
+  g_object_unref (node);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_create_object (GstdSession * session, GstdObject * obj,
+    const gchar * name, const gchar * description, gchar ** response)
+{
+  GstdObject *new;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (G_IS_OBJECT (obj), GSTD_NULL_ARGUMENT);
+
+  // This may mean a potential leak
+  g_warn_if_fail (!*response);
+
+  GST_FIXME_OBJECT (session,
+      "Currently hardcoded to create pipelines and events, we must be "
+      "generic enough to create any type of object");
+
+  if (NULL == name) {
+    /* No name provided, hence no desciption either, but it may contain garbage */
+    description = NULL;
+  }
+
+  ret = gstd_object_create (obj, name, description);
+  if (ret)
+    return ret;
+
+  gstd_object_read (obj, name, &new);
+
+  if (NULL != new) {
+    gstd_object_to_string (new, response);
+    g_object_unref (new);
+  }
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_create (GstdSession * session, GstdObject * obj,
+    const gchar * args, gchar ** response)
+{
+  gchar **tokens = NULL;
+  gchar *name;
+  gchar *description;
+  GstdReturnCode ret;
+
+  // Tokens has the form {<name>, <description>}
+  if (NULL == args) {
+    name = NULL;
+    description = NULL;
+  } else {
+    tokens = g_strsplit (args, " ", 2);
+    name = tokens[0];
+    description = tokens[1];
+  }
+
+  ret = gstd_parser_create_object (session, obj, name, description, response);
+
+  if (tokens)
+    g_strfreev (tokens);
+
+  return ret;
+}
+
+/* Parses an unsigned decimal option value */
+static gboolean
+gstd_parser_option_uint (const gchar * value, guint * out)
+{
+  guint64 number;
+  gchar *end;
+
+  if (!g_ascii_isdigit (value[0])) {
+    return FALSE;
+  }
+
+  number = g_ascii_strtoull (value, &end, 10);
+  if ('\0' != end[0] || number > G_MAXUINT) {
+    return FALSE;
+  }
+
+  *out = number;
+  return TRUE;
+}
+
+/* Parses a comma separated list of the members describing a property,
+ * see gstd_object_set_fields() */
+static gboolean
+gstd_parser_option_fields (const gchar * value, guint * out)
+{
+  gchar **names;
+  guint fields = 0;
+  guint i;
+
+  names = g_strsplit (value, ",", -1);
+
+  for (i = 0; names[i]; i++) {
+    if (!strcmp (names[i], "name")) {
+      fields |= GSTD_FIELD_NAME;
+    } else if (!strcmp (names[i], "value")) {
+      fields |= GSTD_FIELD_VALUE;
+    } else if (!strcmp (names[i], "param_spec")) {
+      fields |= GSTD_FIELD_PARAM_SPEC;
+    } else {
+      fields = 0;
+      break;
+    }
+  }
+
+  g_strfreev (names);
+
+  if (0 == fields) {
+    return FALSE;
+  }
+
+  *out = fields;
+  return TRUE;
+}
+
+/* Serializes an object. args holds the optional "fields=<name>[,...]"
+ * option */
+static GstdReturnCode
+gstd_parser_read (GstdSession * session, GstdObject * obj, const gchar * args,
+    gchar ** response)
+{
+  GstdReturnCode ret = GSTD_EOK;
+  gchar **options;
+  gchar *value;
+  guint fields = GSTD_FIELDS_ALL;
+  guint previous;
+  guint i;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_OBJECT (obj), GSTD_NULL_ARGUMENT);
+
+  // This may mean a potential leak
+  g_warn_if_fail (!*response);
+
+  options = g_strsplit (args ? args : "", " ", -1);
+
+  for (i = 0; options[i]; i++) {
+    if ('\0' == options[i][0]) {
+      continue;
+    }
+
+    value = strchr (options[i], '=');
+    if (value) {
+      *value++ = '\0';
+    }
+
+    if (value && !strcmp (options[i], "fields")) {
+      ret = gstd_parser_option_fields (value, &fields) ? GSTD_EOK :
+          GSTD_BAD_VALUE;
+    } else {
+      ret = GSTD_BAD_VALUE;
+    }
+
+    if (ret) {
+      GST_ERROR_OBJECT (obj, "Invalid read option \"%s\"", options[i]);
+      break;
+    }
+  }
+
+  g_strfreev (options);
+
+  if (ret) {
+    return ret;
+  }
+
+  // Print the raw object, leaving out the members not asked for
+  previous = gstd_object_get_fields ();
+  gstd_object_set_fields (fields);
+  ret = gstd_object_to_string (obj, response);
+  gstd_object_set_fields (previous);
+
+  return ret;
+}
+
+/* Serializes a page of a list. args holds the optional "offset=<n>
+ * limit=<n> prefix=<name> fields=<name>[,...]" options, in any order */
+static GstdReturnCode
+gstd_parser_read_list (GstdSession * session, GstdObject * obj,
+    const gchar * args, gchar ** response)
+{
+  GstdReturnCode ret = GSTD_EOK;
+  gchar **options;
+  gchar *value;
+  const gchar *prefix = NULL;
+  guint offset = 0;
+  guint limit = 0;
+  guint fields = GSTD_FIELDS_ALL;
+  guint previous;
+  guint i;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_LIST (obj), GSTD_BAD_COMMAND);
+
+  options = g_strsplit (args ? args : "", " ", -1);
+
+  for (i = 0; options[i]; i++) {
+    if ('\0' == options[i][0]) {
+      continue;
+    }
+
+    value = strchr (options[i], '=');
+    if (value) {
+      *value++ = '\0';
+    }
+
+    if (!value) {
+      ret = GSTD_BAD_VALUE;
+    } else if (!strcmp (options[i], "offset")) {
+      ret = gstd_parser_option_uint (value, &offset) ? GSTD_EOK :
+          GSTD_BAD_VALUE;
+    } else if (!strcmp (options[i], "limit")) {
+      ret = gstd_parser_option_uint (value, &limit) ? GSTD_EOK :
+          GSTD_BAD_VALUE;
+    } else if (!strcmp (options[i], "prefix")) {
+      prefix = value;
+    } else if (!strcmp (options[i], "fields")) {
+      ret = gstd_parser_option_fields (value, &fields) ? GSTD_EOK :
+          GSTD_BAD_VALUE;
+    } else {
+      ret = GSTD_BAD_VALUE;
+    }
+
+    if (ret) {
+      GST_ERROR_OBJECT (obj, "Invalid list option \"%s\"", options[i]);
+      break;
+    }
+  }
+
+  if (!ret) {
+    previous = gstd_object_get_fields ();
+    gstd_object_set_fields (fields);
+    ret = gstd_list_to_string_range (GSTD_LIST (obj), offset, limit, prefix,
+        response);
+    gstd_object_set_fields (previous);
+  }
+
+  g_strfreev (options);
+
+  return ret;
+}
+
+/* Detaches the ramp running on a property, if any, so values set
+ * explicitly are not overridden by it */
+static void
+gstd_parser_unramp (GObject * target, const gchar * name)
+{
+  GstControlBinding *binding;
+
+  if (!GST_IS_OBJECT (target)) {
+    return;
+  }
+
+  binding = gst_object_get_control_binding (GST_OBJECT (target), name);
+  if (binding) {
+    GST_DEBUG_OBJECT (target, "Detaching the ramp of %s", name);
+    gst_object_remove_control_binding (GST_OBJECT (target), binding);
+    gst_object_unref (binding);
+  }
+}
+
+static GstdReturnCode
+gstd_parser_update (GstdSession * session, GstdObject * obj,
+    const gchar * args, gchar ** response)
+{
+  GQueue *journal;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_OBJECT (obj), GSTD_NULL_ARGUMENT);
+
+  if (!args) {
+    GST_ERROR_OBJECT (obj, "No argument provided for update");
+    ret = GSTD_BAD_VALUE;
+    goto out;
+  }
+  *response = NULL;
+
+  journal = g_private_get (&journal_key);
+  if (journal && GSTD_IS_PROPERTY (obj)) {
+    gstd_parser_journal_record (journal, GSTD_PROPERTY (obj));
+  }
+
+  if (GSTD_IS_PROPERTY (obj)) {
+    gstd_parser_unramp (GSTD_PROPERTY (obj)->target, GSTD_OBJECT_NAME (obj));
+  }
+
+  ret = gstd_object_update (obj, args);
+  if (ret) {
+    goto out;
+  }
+
+  /* Serialize the updated object */
+  gstd_object_to_string (obj, response);
+ out:
+  {
+    return ret;
+  }
+}
+
+static GstdReturnCode
+gstd_parser_delete (GstdSession * session, GstdObject * obj,
+    const gchar * args, gchar ** response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_OBJECT (obj), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  *response = NULL;
+
+  return gstd_object_delete (obj, args);
+}
+
+static GstdReturnCode
+gstd_parser_parse_raw_cmd (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  gchar *tokens[2];
+  gchar *uri, *rest;
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (action, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_warn_if_fail (!*response);
+
+  gstd_parser_split (args, tokens, 2);
+  uri = tokens[0];
+  rest = tokens[1];
+
+  // Alias the empty string to the base
+  if (!uri)
+    uri = "/";
+
+  /* Batches live outside the object tree, creating one at
+   * GSTD_PARSER_BATCH_URI is the raw spelling of the batch verb */
+  if (!g_ascii_strcasecmp ("CREATE", action)
+      && !g_strcmp0 (GSTD_PARSER_BATCH_URI, uri)) {
+    return gstd_parser_batch (session, action, rest, response);
+  }
+
+  ret = gstd_get_by_uri (session, uri, &node);
+  if (ret || NULL == node) {
+    return ret;
+  }
+
+  if (!g_ascii_strcasecmp ("CREATE", action)) {
+    ret = gstd_parser_create (session, node, rest, response);
+  } else if (!g_ascii_strcasecmp ("READ", action)) {
+    ret = gstd_parser_read (session, node, rest, response);
+  } else if (!g_ascii_strcasecmp ("UPDATE", action)) {
+    ret = gstd_parser_update (session, node, rest, response);
+  } else if (!g_ascii_strcasecmp ("DELETE", action)) {
+    ret = gstd_parser_delete (session, node, rest, response);
+  } else {
+    GST_ERROR_OBJECT (session, "Unknown command \"%s\"", action);
+    ret = GSTD_BAD_COMMAND;
+  }
+
+  g_object_unref (node);
+
+  return ret;
+}
+
+/* Splits line in place into the verb and its arguments and finds the
+ * command for the verb */
+static GstdCmd *
+gstd_parser_route (gchar * line, gchar ** action, gchar ** args)
+{
+  gchar *tokens[2];
+  gchar *c;
+
+  gstd_parser_split (line, tokens, 2);
+  *action = tokens[0];
+  *args = tokens[1];
+
+  if (NULL == *action) {
+    return NULL;
+  }
+
+  for (c = *action; *c; c++) {
+    *c = g_ascii_tolower (*c);
+  }
+
+  return g_hash_table_lookup (router, *action);
+}
+
+GstdReturnCode
+gstd_parser_parse_cmd (GstdSession * session, const gchar * cmd,
+    gchar ** response)
+{
+  gchar *line, *action, *args;
+  GstdCmd *route;
+  GstdReturnCode ret = GSTD_BAD_COMMAND;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (cmd, GSTD_NULL_ARGUMENT);
+  g_warn_if_fail (!*response);
+
+  gstd_parser_init ();
+
+  /* A single copy of the line is split in place and handed down to the
+   * handlers, which split their arguments in place as well */
+  line = g_strdup (cmd);
+  route = gstd_parser_route (line, &action, &args);
+  if (route) {
+    ret = route->callback (session, action, args, response);
+  }
+
+  if (ret == GSTD_BAD_COMMAND)
+    GST_ERROR_OBJECT (session, "Unknown command \"%s\"", action);
+  g_free (line);
+
+  return ret;
+}
+
+void
+gstd_parser_parse_cmd_async (GstdSession * session, const gchar * cmd,
+    GCancellable * cancellable, GstdParserReadyFunc func, gpointer user_data)
+{
+  gchar *line, *action, *args;
+  gchar *response = NULL;
+  GstdCmd *route;
+  GstdReturnCode ret = GSTD_BAD_COMMAND;
+
+  g_return_if_fail (GSTD_IS_SESSION (session));
+  g_return_if_fail (cmd);
+  g_return_if_fail (func);
+
+  gstd_parser_init ();
+
+  line = g_strdup (cmd);
+  route = gstd_parser_route (line, &action, &args);
+  if (route && route->async_callback) {
+    route->async_callback (session, action, args, cancellable, func,
+        user_data);
+    g_free (line);
+    return;
+  }
+
+  if (route) {
+    ret = route->callback (session, action, args, &response);
+  }
+
+  if (ret == GSTD_BAD_COMMAND)
+    GST_ERROR_OBJECT (session, "Unknown command \"%s\"", action);
+  g_free (line);
+
+  func (ret, response, user_data);
+}
+
+static GstdReturnCode
+gstd_parser_pipeline_create (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+
+  return gstd_parser_apply (session, gstd_parser_create, args, response,
+      "pipelines", NULL);
+}
+
+static GstdReturnCode
+gstd_parser_pipeline_delete (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  return gstd_parser_apply (session, gstd_parser_delete, args, response,
+      "pipelines", NULL);
+}
+
+static GstdReturnCode
+gstd_parser_pipeline_play (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  return gstd_parser_apply (session, gstd_parser_update, "playing", response,
+      "pipelines", args, "state", NULL);
+}
+
+static GstdReturnCode
+gstd_parser_pipeline_pause (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  return gstd_parser_apply (session, gstd_parser_update, "paused", response,
+      "pipelines", args, "state", NULL);
+}
+
+static GstdReturnCode
+gstd_parser_pipeline_stop (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  return gstd_parser_apply (session, gstd_parser_update, "null", response,
+      "pipelines", args, "state", NULL);
+}
+
+/* Serializes the properties of every element of a pipeline. args holds
+ * the optional "properties=<name>[,...]" allow-list */
+static GstdReturnCode
+gstd_parser_snapshot (GstdSession * session, GstdObject * obj,
+    const gchar * args, gchar ** response)
+{
+  GstdReturnCode ret;
+  gchar **names = NULL;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (GSTD_IS_PIPELINE (obj), GSTD_BAD_COMMAND);
+
+  if (args && g_str_has_prefix (args, "properties=")) {
+    names = g_strsplit (args + strlen ("properties="), ",", -1);
+  } else if (args && '\0' != args[0]) {
+    GST_ERROR_OBJECT (obj, "Invalid snapshot option \"%s\"", args);
+    return GSTD_BAD_VALUE;
+  }
+
+  ret = gstd_pipeline_snapshot (GSTD_PIPELINE (obj), names, response);
+  g_strfreev (names);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_pipeline_snapshot (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  gchar *tokens[2];
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+
+  return gstd_parser_apply (session, gstd_parser_snapshot, tokens[1],
+      response, "pipelines", tokens[0], NULL);
+}
+
+static GstdReturnCode
+gstd_parser_element_set (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  gchar *tokens[4];
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 4);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+  check_argument (tokens[2], GSTD_BAD_COMMAND);
+  check_argument (tokens[3], GSTD_BAD_COMMAND);
+
+  return gstd_parser_apply (session, gstd_parser_update, tokens[3], response,
+      "pipelines", tokens[0], "elements", tokens[1], "properties", tokens[2],
+      NULL);
+}
+
+static GstdReturnCode
+gstd_parser_element_get (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  gchar *tokens[4];
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 4);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+  check_argument (tokens[2], GSTD_BAD_COMMAND);
+
+  /* tokens[3] holds the options of the read, if any */
+  return gstd_parser_apply (session, gstd_parser_read, tokens[3], response,
+      "pipelines", tokens[0], "elements", tokens[1], "properties", tokens[2],
+      NULL);
+}
+
+/* Describes the given properties of target as a "properties" array of
+ * name and value pairs, serialized with the formatter of node. Values are
+ * written as element_get writes them */
+static GstdReturnCode
+gstd_parser_format_values (GstdObject * node, GObject * target,
+    GParamSpec ** pspecs, guint n, gchar ** response)
+{
+  GstdIFormatter *formatter;
+  GValue value = G_VALUE_INIT;
+  guint i;
+
+  gstd_object_formatter_acquire (node);
+  formatter = node->formatter;
+
+  gstd_iformatter_begin_object (formatter);
+  gstd_iformatter_set_member_name (formatter, "properties");
+  gstd_iformatter_begin_array (formatter);
+
+  for (i = 0; i < n; i++) {
+    gstd_iformatter_begin_object (formatter);
+
+    gstd_iformatter_set_member_name (formatter, "name");
+    gstd_iformatter_set_string_value (formatter, pspecs[i]->name);
+
+    g_value_init (&value, pspecs[i]->value_type);
+    g_object_get_property (target, pspecs[i]->name, &value);
+    gstd_iformatter_set_member_name (formatter, "value");
+    gstd_property_format_value (pspecs[i], formatter, &value);
+    g_value_unset (&value);
+
+    gstd_iformatter_end_object (formatter);
+  }
+
+  gstd_iformatter_end_array (formatter);
+  gstd_iformatter_end_object (formatter);
+
+  gstd_iformatter_generate (formatter, response);
+  gstd_object_formatter_release (node, TRUE);
+
+  return GSTD_EOK;
+}
+
+/* Resolves the element at "<pipe> <element>" and the given property names
+ * of it. Unreadable properties are only accepted when writable is set */
+static GstdReturnCode
+gstd_parser_resolve_many (GstdSession * session, const gchar * pipeline,
+    const gchar * name, gchar ** names, guint n, gboolean writable,
+    GstdObject ** node, GstElement ** element, GParamSpec ** pspecs)
+{
+  const GstdSchema *schema;
+  const GstdSchemaProperty *property;
+  GstdReturnCode ret;
+  guint i;
+
+  ret = gstd_parser_lookup (session, node, "pipelines", pipeline, "elements",
+      name, NULL);
+  if (ret || NULL == *node) {
+    return ret ? ret : GSTD_NO_RESOURCE;
+  }
+
+  g_object_get (*node, "gstelement", element, NULL);
+  schema = gstd_schema_get (G_OBJECT_TYPE (*element));
+
+  for (i = 0; i < n; i++) {
+    property = gstd_schema_find (schema, names[i]);
+    if (!property) {
+      GST_ERROR_OBJECT (*node, "No property \"%s\"", names[i]);
+      ret = GSTD_NO_RESOURCE;
+    } else if (writable && (!(property->pspec->flags & G_PARAM_WRITABLE) ||
+            property->pspec->flags & G_PARAM_CONSTRUCT_ONLY)) {
+      GST_ERROR_OBJECT (*node, "Property \"%s\" is not writable", names[i]);
+      ret = GSTD_NO_UPDATE;
+    } else if (!writable && !(property->pspec->flags & G_PARAM_READABLE)) {
+      GST_ERROR_OBJECT (*node, "Property \"%s\" is not readable", names[i]);
+      ret = GSTD_NO_READ;
+    }
+
+    if (ret) {
+      g_clear_object (element);
+      g_clear_object (node);
+      return ret;
+    }
+
+    pspecs[i] = property->pspec;
+  }
+
+  return GSTD_EOK;
+}
+
+/* Sets several properties of an element at once. args holds "<pipe>
+ * <element> <name>=<value> ...", values may be quoted as in a shell.
+ * Every value is parsed before any is set, so a bad one changes nothing,
+ * and the element is notified once all of them are set */
+static GstdReturnCode
+gstd_parser_element_set_many (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  gchar *tokens[3];
+  gchar **assignments = NULL;
+  gchar **names = NULL;
+  gchar *value;
+  GParamSpec **pspecs = NULL;
+  GValue *values = NULL;
+  GstdObject *node = NULL;
+  GstElement *element = NULL;
+  GQueue *journal;
+  GError *error = NULL;
+  GstdReturnCode ret;
+  gint argc;
+  guint n;
+  guint i;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 3);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+  check_argument (tokens[2], GSTD_BAD_COMMAND);
+
+  if (!g_shell_parse_argv (tokens[2], &argc, &assignments, &error)) {
+    GST_ERROR_OBJECT (session, "Invalid assignments: %s", error->message);
+    g_error_free (error);
+    return GSTD_BAD_VALUE;
+  }
+  n = argc;
+
+  names = g_new0 (gchar *, n + 1);
+  for (i = 0; i < n; i++) {
+    value = strchr (assignments[i], '=');
+    if (!value) {
+      GST_ERROR_OBJECT (session, "Invalid assignment \"%s\"",
+          assignments[i]);
+      ret = GSTD_BAD_VALUE;
+      goto out;
+    }
+    names[i] = g_strndup (assignments[i], value - assignments[i]);
+  }
+
+  pspecs = g_new0 (GParamSpec *, n);
+  ret = gstd_parser_resolve_many (session, tokens[0], tokens[1], names, n,
+      TRUE, &node, &element, pspecs);
+  if (ret) {
+    goto out;
+  }
+
+  values = g_new0 (GValue, n);
+  for (i = 0; i < n; i++) {
+    value = strchr (assignments[i], '=') + 1;
+    g_value_init (&values[i], pspecs[i]->value_type);
+    /* Parsed and range checked as element_set would */
+    ret = gstd_property_parse_value (pspecs[i], value, &values[i]);
+    if (ret) {
+      GST_ERROR_OBJECT (node, "Invalid value \"%s\" for %s", value,
+          pspecs[i]->name);
+      goto out;
+    }
+  }
+
+  journal = g_private_get (&journal_key);
+  if (journal) {
+    for (i = 0; i < n; i++) {
+      gstd_parser_journal_save (journal, G_OBJECT (element), pspecs[i]);
+    }
+  }
+
+  g_object_freeze_notify (G_OBJECT (element));
+  for (i = 0; i < n; i++) {
+    gstd_parser_unramp (G_OBJECT (element), pspecs[i]->name);
+    g_object_set_property (G_OBJECT (element), pspecs[i]->name, &values[i]);
+  }
+  g_object_thaw_notify (G_OBJECT (element));
+
+  ret = gstd_parser_format_values (node, G_OBJECT (element), pspecs, n,
+      response);
+
+out:
+  if (values) {
+    for (i = 0; i < n; i++) {
+      if (G_IS_VALUE (&values[i])) {
+        g_value_unset (&values[i]);
+      }
+    }
+    g_free (values);
+  }
+  g_free (pspecs);
+  g_strfreev (names);
+  g_strfreev (assignments);
+  if (element) {
+    gst_object_unref (element);
+  }
+  if (node) {
+    g_object_unref (node);
+  }
+
+  return ret;
+}
+
+/* Reads several properties of an element at once. args holds "<pipe>
+ * <element> <name> ..." */
+static GstdReturnCode
+gstd_parser_element_get_many (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  gchar *tokens[3];
+  gchar **names;
+  GParamSpec **pspecs;
+  GstdObject *node = NULL;
+  GstElement *element = NULL;
+  GstdReturnCode ret;
+  guint n = 0;
+  guint i;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 3);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+  check_argument (tokens[2], GSTD_BAD_COMMAND);
+
+  /* Drop the empty names left by repeated spaces */
+  names = g_strsplit (tokens[2], " ", -1);
+  for (i = 0; names[i]; i++) {
+    if ('\0' != names[i][0]) {
+      names[n++] = names[i];
+    } else {
+      g_free (names[i]);
+    }
+  }
+  names[n] = NULL;
+
+  pspecs = g_new0 (GParamSpec *, MAX (n, 1));
+  ret = gstd_parser_resolve_many (session, tokens[0], tokens[1], names, n,
+      FALSE, &node, &element, pspecs);
+  if (!ret) {
+    ret = gstd_parser_format_values (node, G_OBJECT (element), pspecs, n,
+        response);
+    gst_object_unref (element);
+    g_object_unref (node);
+  }
+
+  g_free (pspecs);
+  g_strfreev (names);
+
+  return ret;
+}
+
+/* Control values are doubles, 64 bit ranges wider than 2^53 can't be
+ * interpolated without skipping integers */
+#define GSTD_PARSER_RAMP_MAX_EXACT 9007199254740992.0
+
+/* Gets the range of a numeric property, the span control values between
+ * 0 and 1 are mapped to by a direct control binding */
+static gboolean
+gstd_parser_ramp_range (GParamSpec * pspec, gdouble * min, gdouble * max)
+{
+  switch (pspec->value_type) {
+    case G_TYPE_INT:
+      *min = G_PARAM_SPEC_INT (pspec)->minimum;
+      *max = G_PARAM_SPEC_INT (pspec)->maximum;
+      break;
+    case G_TYPE_UINT:
+      *min = G_PARAM_SPEC_UINT (pspec)->minimum;
+      *max = G_PARAM_SPEC_UINT (pspec)->maximum;
+      break;
+    case G_TYPE_INT64:
+      *min = G_PARAM_SPEC_INT64 (pspec)->minimum;
+      *max = G_PARAM_SPEC_INT64 (pspec)->maximum;
+      break;
+    case G_TYPE_UINT64:
+      *min = G_PARAM_SPEC_UINT64 (pspec)->minimum;
+      *max = G_PARAM_SPEC_UINT64 (pspec)->maximum;
+      break;
+    case G_TYPE_FLOAT:
+      *min = G_PARAM_SPEC_FLOAT (pspec)->minimum;
+      *max = G_PARAM_SPEC_FLOAT (pspec)->maximum;
+      break;
+    case G_TYPE_DOUBLE:
+      *min = G_PARAM_SPEC_DOUBLE (pspec)->minimum;
+      *max = G_PARAM_SPEC_DOUBLE (pspec)->maximum;
+      break;
+    default:
+      return FALSE;
+  }
+
+  if (*min < -GSTD_PARSER_RAMP_MAX_EXACT || *max > GSTD_PARSER_RAMP_MAX_EXACT) {
+    switch (pspec->value_type) {
+      case G_TYPE_INT64:
+      case G_TYPE_UINT64:
+        return FALSE;
+      default:
+        break;
+    }
+  }
+
+  return *max > *min;
+}
+
+/* Parses the whole of the target value and of the duration */
+static gboolean
+gstd_parser_ramp_parse (const gchar * svalue, const gchar * sduration,
+    gdouble * target, guint64 * duration)
+{
+  gchar *end;
+
+  errno = 0;
+
+  *target = g_ascii_strtod (svalue, &end);
+  if (errno || end == svalue || '\0' != *end) {
+    return FALSE;
+  }
+
+  if ('-' == sduration[0]) {
+    return FALSE;
+  }
+
+  *duration = g_ascii_strtoull (sduration, &end, 10);
+  if (errno || end == sduration || '\0' != *end) {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/* Gets the stream time the pipeline holding element is at, the time
+ * control bindings are sampled at */
+static GstClockTime
+gstd_parser_ramp_position (GstElement * element)
+{
+  GstObject *top = gst_object_ref (element);
+  GstObject *parent;
+  gint64 position;
+
+  while ((parent = gst_object_get_parent (top))) {
+    gst_object_unref (top);
+    top = parent;
+  }
+
+  if (!gst_element_query_position (GST_ELEMENT (top), GST_FORMAT_TIME,
+          &position) || position < 0) {
+    position = 0;
+  }
+  gst_object_unref (top);
+
+  return position;
+}
+
+/* Moves a numeric property to a target value over a duration, in
+ * nanoseconds. args holds "<pipe> <element> <property> <target>
+ * <duration> [<curve>]", where curve is an interpolation mode nick such
+ * as "linear", the default, or "cubic". The values in between are
+ * sampled by the element itself as it processes buffers, through a
+ * control binding that starts at the current position of the pipeline.
+ * The property holds the target once done, until it is set again or
+ * ramped elsewhere */
+static GstdReturnCode
+gstd_parser_element_ramp (GstdSession * session, gchar * action,
+    gchar * args, gchar ** response)
+{
+  gchar *tokens[6];
+  GParamSpec *pspec;
+  GstdObject *node = NULL;
+  GstElement *element = NULL;
+  GstControlSource *source;
+  GstControlBinding *binding;
+  GEnumClass *modes;
+  GEnumValue *mode;
+  GValue value = G_VALUE_INIT;
+  GValue current = G_VALUE_INIT;
+  GstClockTime start;
+  guint64 duration;
+  gdouble target, min, max;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 6);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+  check_argument (tokens[2], GSTD_BAD_COMMAND);
+  check_argument (tokens[3], GSTD_BAD_COMMAND);
+  check_argument (tokens[4], GSTD_BAD_COMMAND);
+
+  ret = gstd_parser_resolve_many (session, tokens[0], tokens[1], &tokens[2],
+      1, TRUE, &node, &element, &pspec);
+  if (ret) {
+    return ret;
+  }
+
+  modes = g_type_class_ref (GST_TYPE_INTERPOLATION_MODE);
+  mode = g_enum_get_value_by_nick (modes, tokens[5] ? tokens[5] : "linear");
+
+  if (!(pspec->flags & GST_PARAM_CONTROLLABLE)) {
+    GST_ERROR_OBJECT (node, "%s is not controllable, it can't be ramped",
+        pspec->name);
+    ret = GSTD_BAD_VALUE;
+  } else if (!mode) {
+    GST_ERROR_OBJECT (node, "Unknown curve \"%s\"", tokens[5]);
+    ret = GSTD_BAD_VALUE;
+  } else if (!gstd_parser_ramp_range (pspec, &min, &max)) {
+    GST_ERROR_OBJECT (node, "%s is not numeric or its range is too wide, it "
+        "can't be ramped", pspec->name);
+    ret = GSTD_BAD_VALUE;
+  } else if (!gstd_parser_ramp_parse (tokens[3], tokens[4], &target,
+          &duration) || target < min || target > max) {
+    GST_ERROR_OBJECT (node, "Invalid ramp of %s to %s over %s ns",
+        pspec->name, tokens[3], tokens[4]);
+    ret = GSTD_BAD_VALUE;
+  }
+
+  if (ret) {
+    goto out;
+  }
+
+  if (0 == duration) {
+    /* Nothing to interpolate, jump to the target */
+    gstd_parser_unramp (G_OBJECT (element), pspec->name);
+    g_value_init (&value, G_TYPE_DOUBLE);
+    g_value_init (&current, pspec->value_type);
+    g_value_set_double (&value, target);
+    g_value_transform (&value, &current);
+    g_object_set_property (G_OBJECT (element), pspec->name, &current);
+    g_value_unset (&current);
+    g_value_unset (&value);
+  } else {
+    g_value_init (&current, pspec->value_type);
+    g_value_init (&value, G_TYPE_DOUBLE);
+    g_object_get_property (G_OBJECT (element), pspec->name, &current);
+    g_value_transform (&current, &value);
+
+    start = gstd_parser_ramp_position (element);
+
+    /* Direct bindings map control values from 0 to 1 onto the range of
+     * the property */
+    source = gst_interpolation_control_source_new ();
+    g_object_set (source, "mode", mode->value, NULL);
+    gst_timed_value_control_source_set (GST_TIMED_VALUE_CONTROL_SOURCE
+        (source), start, (g_value_get_double (&value) - min) / (max - min));
+    gst_timed_value_control_source_set (GST_TIMED_VALUE_CONTROL_SOURCE
+        (source), start + duration, (target - min) / (max - min));
+
+    /* Replaces the previous ramp of the property, if any */
+    binding = gst_direct_control_binding_new (GST_OBJECT (element),
+        pspec->name, source);
+    gst_object_unref (source);
+
+    if (!gst_object_add_control_binding (GST_OBJECT (element), binding)) {
+      GST_ERROR_OBJECT (node, "Cannot bind %s to a control source",
+          pspec->name);
+      gst_object_unref (gst_object_ref_sink (binding));
+      g_value_unset (&current);
+      g_value_unset (&value);
+      ret = GSTD_BAD_VALUE;
+      goto out;
+    }
+
+    GST_INFO_OBJECT (node, "Ramping %s from %f to %f over %" GST_TIME_FORMAT
+        " at %" GST_TIME_FORMAT, pspec->name, g_value_get_double (&value),
+        target, GST_TIME_ARGS (duration), GST_TIME_ARGS (start));
+
+    g_value_unset (&current);
+    g_value_unset (&value);
+  }
+
+  ret = gstd_parser_format_values (node, G_OBJECT (element), &pspec, 1,
+      response);
+
+out:
+  g_type_class_unref (modes);
+  gst_object_unref (element);
+  g_object_unref (node);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_list_pipelines (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+
+  return gstd_parser_apply (session, gstd_parser_read_list, args, response,
+      "pipelines", NULL);
+}
+
+static GstdReturnCode
+gstd_parser_list_elements (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  gchar *tokens[2];
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+
+  return gstd_parser_apply (session, gstd_parser_read_list, tokens[1],
+      response, "pipelines", tokens[0], "elements", NULL);
+}
+
+static GstdReturnCode
+gstd_parser_list_properties (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  gchar *tokens[3];
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 3);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  return gstd_parser_apply (session, gstd_parser_read_list, tokens[2],
+      response, "pipelines", tokens[0], "elements", tokens[1], "properties",
+      NULL);
+}
+
+static GstdReturnCode
+gstd_parser_bus_read (GstdSession *session, gchar * action,
+    gchar *pipeline, gchar **response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (pipeline, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  return gstd_parser_apply (session, gstd_parser_read, NULL, response,
+      "pipelines", pipeline, "bus", "message", NULL);
+}
+
+static void
+gstd_parser_bus_read_async (GstdSession * session, gchar * action,
+    gchar * pipeline, GCancellable * cancellable, GstdParserReadyFunc func,
+    gpointer user_data)
+{
+  GstdParserAsync *async;
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  if (NULL == pipeline) {
+    func (GSTD_NULL_ARGUMENT, NULL, user_data);
+    return;
+  }
+
+  ret = gstd_parser_lookup (session, &node, "pipelines", pipeline, "bus",
+      NULL);
+  if (ret) {
+    func (ret, NULL, user_data);
+    return;
+  }
+
+  async = g_slice_new (GstdParserAsync);
+  async->func = func;
+  async->user_data = user_data;
+  async->pretty = gstd_object_get_pretty ();
+  async->binary = gstd_object_get_binary ();
+
+  gstd_pipeline_bus_read_async (GSTD_PIPELINE_BUS (node), cancellable,
+      gstd_parser_bus_read_done, async);
+  g_object_unref (node);
+}
+
+/* Serializes the message the same way a blocking read does, no message
+ * results in an empty response */
+static void
+gstd_parser_bus_read_done (GstdPipelineBus * bus, GstMessage * message,
+    gpointer user_data)
+{
+  GstdParserAsync *async = user_data;
+  GstdObject *msg;
+  gchar *response = NULL;
+  gboolean pretty;
+  gboolean binary;
+
+  /* Completes on the posting thread, serialize as the caller asked */
+  pretty = gstd_object_get_pretty ();
+  binary = gstd_object_get_binary ();
+  gstd_object_set_pretty (async->pretty);
+  gstd_object_set_binary (async->binary);
+
+  if (message) {
+    msg = GSTD_OBJECT (gstd_bus_msg_factory_make (message));
+    gstd_object_to_string (msg, &response);
+    g_object_unref (msg);
+  }
+
+  async->func (GSTD_EOK, response, async->user_data);
+  g_slice_free (GstdParserAsync, async);
+
+  gstd_object_set_pretty (pretty);
+  gstd_object_set_binary (binary);
+}
+
+GstdReturnCode
+gstd_parser_bus_subscribe (GstdSession * session, gchar * args,
+    guint max_queued, GstdPipelineBusNotify notify, gpointer user_data,
+    GDestroyNotify destroy, GstdPipelineBusSubscription ** subscription)
+{
+  GValue types = G_VALUE_INIT;
+  GstdObject *node;
+  GstdReturnCode ret;
+  gchar *tokens[2];
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (subscription, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  g_value_init (&types, GSTD_TYPE_MSG_TYPE);
+  if (!gst_value_deserialize (&types, tokens[1])) {
+    g_value_unset (&types);
+    return GSTD_BAD_VALUE;
+  }
+
+  ret = gstd_parser_lookup (session, &node, "pipelines", tokens[0], "bus",
+      NULL);
+  if (ret) {
+    g_value_unset (&types);
+    return ret;
+  }
+
+  *subscription = gstd_pipeline_bus_subscribe (GSTD_PIPELINE_BUS (node),
+      g_value_get_flags (&types), max_queued, notify, user_data, destroy);
+
+  g_value_unset (&types);
+  g_object_unref (node);
+
+  return GSTD_EOK;
+}
+
+gchar *
+gstd_parser_bus_event (GstMessage * message, guint dropped)
+{
+  GstdObject *msg;
+  gchar *output = NULL;
+  gchar *event;
+
+  g_return_val_if_fail (message, NULL);
+
+  msg = GSTD_OBJECT (gstd_bus_msg_factory_make (message));
+  gstd_object_to_string (msg, &output);
+  g_object_unref (msg);
+
+  if (gstd_object_get_binary ()) {
+    event = gstd_parser_envelope_binary (GSTD_EOK, output, NULL, dropped);
+  } else if (gstd_object_get_pretty ()) {
+    event = g_strdup_printf ("{\n  \"code\" : %d,\n  \"description\" : \"%s\",\n"
+        "  \"dropped\" : %u,\n  \"response\" : %s\n}", GSTD_EOK,
+        gstd_return_code_to_string (GSTD_EOK), dropped,
+        output ? output : "null");
+  } else {
+    event = g_strdup_printf ("{\"code\":%d,\"description\":\"%s\","
+        "\"dropped\":%u,\"response\":%s}", GSTD_EOK,
+        gstd_return_code_to_string (GSTD_EOK), dropped,
+        output ? output : "null");
+  }
+  g_free (output);
+
+  return event;
+}
+
+GstdReturnCode
+gstd_parser_watch (GstdSession * session, gchar * args,
+    GMainContext * context, GstdPropertyWatchFunc func, gpointer user_data,
+    GDestroyNotify destroy, GstdPropertyWatch ** watch)
+{
+  GstdObject *node;
+  GstdReturnCode ret = GSTD_EOK;
+  gchar **options;
+  gchar *value;
+  gchar *end;
+  guint64 interval = 0;
+  guint64 period = 0;
+  gdouble deadband = 0;
+  guint i;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (watch, GSTD_NULL_ARGUMENT);
+
+  options = g_strsplit (args, " ", -1);
+  if (!options[0] || '\0' == options[0][0]) {
+    g_strfreev (options);
+    return GSTD_BAD_COMMAND;
+  }
+
+  for (i = 1; options[i]; i++) {
+    if ('\0' == options[i][0]) {
+      continue;
+    }
+
+    value = strchr (options[i], '=');
+    if (!value || '\0' == value[1]) {
+      ret = GSTD_BAD_VALUE;
+      break;
+    }
+    *value++ = '\0';
+
+    if (!strcmp (options[i], "interval")) {
+      interval = g_ascii_strtoull (value, &end, 10);
+    } else if (!strcmp (options[i], "period")) {
+      period = g_ascii_strtoull (value, &end, 10);
+    } else if (!strcmp (options[i], "deadband")) {
+      deadband = g_ascii_strtod (value, &end);
+      if (deadband < 0) {
+        end = value;
+      }
+    } else {
+      end = value;
+    }
+
+    if ('\0' != *end || interval > G_MAXUINT || period > G_MAXUINT) {
+      ret = GSTD_BAD_VALUE;
+      break;
+    }
+  }
+
+  if (ret) {
+    GST_ERROR_OBJECT (session, "Invalid watch option \"%s\"", options[i]);
+    g_strfreev (options);
+    return ret;
+  }
+
+  ret = gstd_get_by_uri (session, options[0], &node);
+  g_strfreev (options);
+  if (ret) {
+    return ret;
+  }
+
+  if (!GSTD_IS_PROPERTY (node)) {
+    GST_ERROR_OBJECT (session, "Only properties can be watched");
+    g_object_unref (node);
+    return GSTD_BAD_COMMAND;
+  }
+
+  *watch = gstd_property_watch (GSTD_PROPERTY (node), context, interval,
+      period, deadband, func, user_data, destroy);
+  g_object_unref (node);
+
+  return *watch ? GSTD_EOK : GSTD_NO_RESOURCE;
+}
+
+gchar *
+gstd_parser_watch_event (const gchar * uri, GstdPropertyWatch * watch)
+{
+  GstdObject *property;
+  GstdIFormatter *formatter;
+  GstdReturnCode ret;
+  GValue code = G_VALUE_INIT;
+  gchar *event = NULL;
+  guint previous;
+
+  g_return_val_if_fail (uri, NULL);
+  g_return_val_if_fail (watch, NULL);
+
+  property = GSTD_OBJECT (gstd_property_watch_get_property (watch));
+
+  /* The property's formatter follows the connection's format, the whole
+   * event is built with it so the client's URI is escaped as any other
+   * string */
+  gstd_object_formatter_acquire (property);
+  formatter = property->formatter;
+
+  gstd_iformatter_begin_object (formatter);
+
+  g_value_init (&code, G_TYPE_INT);
+  g_value_set_int (&code, GSTD_EOK);
+  gstd_iformatter_set_member_name (formatter, "code");
+  gstd_iformatter_set_value (formatter, &code);
+  g_value_unset (&code);
+
+  gstd_iformatter_set_member_name (formatter, "description");
+  gstd_iformatter_set_string_value (formatter,
+      gstd_return_code_to_string (GSTD_EOK));
+
+  gstd_iformatter_set_member_name (formatter, "watch");
+  gstd_iformatter_set_string_value (formatter, uri);
+
+  /* The param spec doesn't change, leave it out of every update */
+  previous = gstd_object_get_fields ();
+  gstd_object_set_fields (GSTD_FIELD_NAME | GSTD_FIELD_VALUE);
+  gstd_iformatter_set_member_name (formatter, "response");
+  ret = gstd_property_format (GSTD_PROPERTY (property), formatter);
+  gstd_object_set_fields (previous);
+
+  if (GSTD_EOK == ret) {
+    gstd_iformatter_end_object (formatter);
+    gstd_iformatter_generate (formatter, &event);
+  }
+
+  gstd_object_formatter_release (property, GSTD_EOK == ret);
+
+  if (!event) {
+    event = gstd_parser_envelope (ret, NULL, NULL);
+  }
+
+  return event;
+}
+
+static GstdReturnCode
+gstd_parser_bus_filter (GstdSession *session, gchar *action,
+    gchar *args, gchar **response)
+{
+  gchar *tokens[2];
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  return gstd_parser_apply (session, gstd_parser_update, tokens[1], response,
+      "pipelines", tokens[0], "bus", "types", NULL);
+}
+
+static GstdReturnCode
+gstd_parser_bus_timeout (GstdSession *session, gchar *action, gchar *args,
+    gchar **response)
+{
+  gchar *tokens[2];
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  check_argument (tokens[1], GSTD_BAD_COMMAND);
+
+  return gstd_parser_apply (session, gstd_parser_update, tokens[1], response,
+      "pipelines", tokens[0], "bus", "timeout", NULL);
+}
+
+/* Events take their parameters as description, which may be missing to
+ * use the defaults */
+static GstdReturnCode
+gstd_parser_event_create (GstdSession * session, const gchar * pipeline,
+    const gchar * event, const gchar * description, gchar ** response)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+
+  ret = gstd_parser_lookup (session, &node, "pipelines", pipeline, "event",
+      NULL);
+  if (ret) {
+    return ret;
+  }
+
+  ret = gstd_parser_create_object (session, node, event, description,
+      response);
+  g_object_unref (node);
+
+  return ret;
+}
+
+static GstdReturnCode
+gstd_parser_event_eos (GstdSession *session, gchar *action, gchar *pipeline,
+    gchar **response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (pipeline, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  return gstd_parser_event_create (session, pipeline, "eos", NULL, response);
+}
+
+static GstdReturnCode
+gstd_parser_event_seek (GstdSession *session, gchar *action, gchar *args,
+    gchar **response)
+{
+  gchar *tokens[2];
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  // We don't check for the second token since we want to allow defaults
+
+  return gstd_parser_event_create (session, tokens[0], "seek", tokens[1],
+      response);
+}
+
+static GstdReturnCode
+gstd_parser_event_flush_start (GstdSession *session, gchar *action, gchar *pipeline,
+    gchar **response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (pipeline, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  return gstd_parser_event_create (session, pipeline, "flush_start", NULL,
+      response);
+}
+
+static GstdReturnCode
+gstd_parser_event_flush_stop (GstdSession *session, gchar *action, gchar *args,
+    gchar **response)
+{
+  gchar *tokens[2];
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (args, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  gstd_parser_split (args, tokens, 2);
+  check_argument (tokens[0], GSTD_BAD_COMMAND);
+  // We don't check for the second token since we want to allow defaults
+
+  return gstd_parser_event_create (session, tokens[0], "flush_stop",
+      tokens[1], response);
+}
+
+static GstdReturnCode
+gstd_parser_debug_enable (GstdSession *session, gchar *action, gchar *enabled,
+    gchar **response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  check_argument (enabled, GSTD_BAD_COMMAND);
+
+  return gstd_parser_apply (session, gstd_parser_update, enabled, response,
+      "debug", "enable", NULL);
+}
+
+static GstdReturnCode
+gstd_parser_debug_threshold (GstdSession *session, gchar *action, gchar *threshold,
+    gchar **response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  check_argument (threshold, GSTD_BAD_COMMAND);
+
+  return gstd_parser_apply (session, gstd_parser_update, threshold, response,
+      "debug", "threshold", NULL);
+}
+
+static GstdReturnCode
+gstd_parser_debug_color (GstdSession *session, gchar *action, gchar *colored,
+    gchar **response)
+{
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  check_argument (colored, GSTD_BAD_COMMAND);
+
+  return gstd_parser_apply (session, gstd_parser_update, colored, response,
+      "debug", "color", NULL);
+}
+
+static void
+gstd_parser_journal_record (GQueue * journal, GstdProperty * property)
+{
+  GParamSpec *pspec;
+
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (property->target),
+      GSTD_OBJECT_NAME (property));
+  if (!pspec) {
+    /* The update itself will fail */
+    return;
+  }
+
+  gstd_parser_journal_save (journal, property->target, pspec);
+}
+
+/* Records the current value of a property of target */
+static void
+gstd_parser_journal_save (GQueue * journal, GObject * target,
+    GParamSpec * pspec)
+{
+  GstdParserUndo *undo;
+
+  if (!(pspec->flags & G_PARAM_READABLE)) {
+    /* There is no way to restore it */
+    return;
+  }
+
+  undo = g_slice_new0 (GstdParserUndo);
+  undo->target = g_object_ref (target);
+  undo->name = pspec->name;
+  g_value_init (&undo->value, pspec->value_type);
+  g_object_get_property (undo->target, undo->name, &undo->value);
+
+  g_queue_push_head (journal, undo);
+}
+
+static void
+gstd_parser_undo_free (GstdParserUndo * undo)
+{
+  g_value_unset (&undo->value);
+  g_object_unref (undo->target);
+  g_slice_free (GstdParserUndo, undo);
+}
+
+/* Restores the recorded values, newest first */
+static void
+gstd_parser_journal_rollback (GQueue * journal)
+{
+  GstdParserUndo *undo;
+
+  while ((undo = g_queue_pop_head (journal))) {
+    GST_DEBUG ("Restoring %s", undo->name);
+    g_object_set_property (undo->target, undo->name, &undo->value);
+    gstd_parser_undo_free (undo);
+  }
+}
+
+static void
+gstd_parser_journal_free (GQueue * journal)
+{
+  g_queue_free_full (journal, (GDestroyNotify) gstd_parser_undo_free);
+}
+
+static GstdReturnCode
+gstd_parser_batch (GstdSession * session, gchar * action, gchar * args,
+    gchar ** response)
+{
+  JsonParser *parser;
+  JsonNode *root;
+  JsonArray *commands;
+  GQueue *journal = NULL;
+  GString *results;
+  GstdIFormatter *binary = NULL;
+  GError *error = NULL;
+  gchar *output;
+  gchar *result;
+  const gchar *cmd;
+  gboolean atomic = FALSE;
+  GstdReturnCode ret = GSTD_EOK;
+  GstdReturnCode cmd_ret;
+  guint i;
+
+  g_return_val_if_fail (GSTD_IS_SESSION (session), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (response, GSTD_NULL_ARGUMENT);
+
+  check_argument (args, GSTD_BAD_COMMAND);
+
+  if (g_private_get (&journal_key)) {
+    GST_ERROR_OBJECT (session, "Batches can't be nested");
+    return GSTD_BAD_COMMAND;
+  }
+
+  if (g_str_has_prefix (args, "atomic ")) {
+    atomic = TRUE;
+    args += strlen ("atomic ");
+  }
+
+  parser = json_parser_new ();
+  if (!json_parser_load_from_data (parser, args, -1, &error)) {
+    GST_ERROR_OBJECT (session, "Malformed batch: %s", error->message);
+    g_error_free (error);
+    g_object_unref (parser);
+    return GSTD_BAD_COMMAND;
+  }
+
+  root = json_parser_get_root (parser);
+  if (!JSON_NODE_HOLDS_ARRAY (root)) {
+    GST_ERROR_OBJECT (session, "A batch must be an array of commands");
+    g_object_unref (parser);
+    return GSTD_BAD_COMMAND;
+  }
+  commands = json_node_get_array (root);
+
+  if (atomic) {
+    journal = g_queue_new ();
+    g_private_set (&journal_key, journal);
+  }
+
+  results = g_string_new ("[");
+  if (gstd_object_get_binary ()) {
+    binary = g_object_new (GSTD_TYPE_CBOR_WRITER, NULL);
+    gstd_iformatter_begin_array (binary);
+  }
+
+  for (i = 0; i < json_array_get_length (commands); i++) {
+    cmd = json_array_get_string_element (commands, i);
+    output = NULL;
+
+    if (cmd) {
+      cmd_ret = gstd_parser_parse_cmd (session, cmd, &output);
+    } else {
+      GST_ERROR_OBJECT (session, "Batch entry %u is not a string", i);
+      cmd_ret = GSTD_BAD_COMMAND;
+    }
+
+    result = gstd_parser_envelope (cmd_ret, output, NULL);
+    if (binary) {
+      gstd_cbor_writer_add_encoded (binary, result);
+    } else {
+      if (gstd_object_get_pretty ()) {
+        g_string_append (results, i ? ",\n" : "\n");
+      } else if (i) {
+        g_string_append_c (results, ',');
+      }
+      g_string_append (results, result);
+    }
+    g_free (result);
+    g_free (output);
+
+    /* The batch reports the first failure, atomic batches stop there
+     * and restore every property they had already changed */
+    if (cmd_ret && !ret) {
+      ret = cmd_ret;
+    }
+    if (cmd_ret && atomic) {
+      gstd_parser_journal_rollback (journal);
+      break;
+    }
+  }
+
+  if (binary) {
+    gstd_iformatter_end_array (binary);
+    gstd_iformatter_generate (binary, response);
+    g_object_unref (binary);
+    g_string_free (results, TRUE);
+  } else {
+    g_string_append (results, gstd_object_get_pretty () ? "\n]" : "]");
+    *response = g_string_free (results, FALSE);
+  }
+
+  if (atomic) {
+    g_private_set (&journal_key, NULL);
+    gstd_parser_journal_free (journal);
+  }
+
+  g_object_unref (parser);
+
+  return ret;
+}
+
+/* The envelope as a CBOR map, a negative drop count is left out */
+static gchar *
+gstd_parser_envelope_binary (GstdReturnCode ret, const gchar * output,
+    const gchar * id, gint64 dropped)
+{
+  GstdIFormatter *formatter;
+  GValue value = G_VALUE_INIT;
+  gchar *envelope = NULL;
+
+  formatter = g_object_new (GSTD_TYPE_CBOR_WRITER, NULL);
+  gstd_iformatter_begin_object (formatter);
+
+  if (id) {
+    g_value_init (&value, G_TYPE_UINT64);
+    g_value_set_uint64 (&value, g_ascii_strtoull (id, NULL, 10));
+    gstd_iformatter_set_member_name (formatter, "id");
+    gstd_iformatter_set_value (formatter, &value);
+    g_value_unset (&value);
+  }
+
+  g_value_init (&value, G_TYPE_INT);
+  g_value_set_int (&value, ret);
+  gstd_iformatter_set_member_name (formatter, "code");
+  gstd_iformatter_set_value (formatter, &value);
+  g_value_unset (&value);
+
+  gstd_iformatter_set_member_name (formatter, "description");
+  gstd_iformatter_set_string_value (formatter,
+      gstd_return_code_to_string (ret));
+
+  if (dropped >= 0) {
+    g_value_init (&value, G_TYPE_INT64);
+    g_value_set_int64 (&value, dropped);
+    gstd_iformatter_set_member_name (formatter, "dropped");
+    gstd_iformatter_set_value (formatter, &value);
+    g_value_unset (&value);
+  }
+
+  gstd_iformatter_set_member_name (formatter, "response");
+  gstd_cbor_writer_add_encoded (formatter, output);
+
+  gstd_iformatter_end_object (formatter);
+  gstd_iformatter_generate (formatter, &envelope);
+  g_object_unref (formatter);
+
+  return envelope;
+}
+
+gchar *
+gstd_parser_envelope (GstdReturnCode ret, const gchar * output,
+    const gchar * id)
+{
+  const gchar *description = NULL;
+
+  if (gstd_object_get_binary ()) {
+    return gstd_parser_envelope_binary (ret, output, id, -1);
+  }
+
+  description = gstd_return_code_to_string(ret);
+
+  if (!gstd_object_get_pretty ()) {
+    if (id) {
+      return g_strdup_printf ("{\"id\":%s,\"code\":%d,\"description\":"
+          "\"%s\",\"response\":%s}", id, ret, description,
+          output ? output : "null");
+    }
+
+    return g_strdup_printf ("{\"code\":%d,\"description\":\"%s\","
+        "\"response\":%s}", ret, description, output ? output : "null");
+  }
+
+  if (id) {
+    return
+        g_strdup_printf ("{\n  \"id\" : %s,\n  \"code\" : %d,\n  \"description\" : \"%s\",\n  \"response\" : %s\n}", id, ret, description,
+        output ? output : "null");
+  }
+
+  return
+      g_strdup_printf ("{\n  \"code\" : %d,\n  \"description\" : \"%s\",\n  \"response\" : %s\n}", ret, description,
+      output ? output : "null");
+}
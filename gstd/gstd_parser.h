@@ -0,0 +1,156 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifndef __GSTD_PARSER_H__
+#define __GSTD_PARSER_H__
+
+#include <glib.h>
+#include <gio/gio.h>
+#include "gstd_return_codes.h"
+#include "gstd_session.h"
+#include "gstd_pipeline_bus.h"
+#include "gstd_property.h"
+
+G_BEGIN_DECLS
+
+/**
+ * gstd_parser_parse_cmd:
+ * @session: The session the command operates on
+ * @cmd: A command such as "pipeline_create p0 fakesrc ! fakesink"
+ * @response: Placeholder for the serialized result, must be NULL. Free
+ * with g_free after usage
+ *
+ * Executes a command from the gstd command set. Shared by every IPC that
+ * speaks the textual protocol.
+ *
+ * Returns: A GstdReturnCode with the execution status
+ */
+GstdReturnCode gstd_parser_parse_cmd (GstdSession * session,
+    const gchar * cmd, gchar ** response);
+
+/**
+ * GstdParserReadyFunc:
+ * @ret: The code returned by the command
+ * @response: (transfer full) (nullable): The serialized result. Free
+ * with g_free after usage
+ * @user_data: The data passed to gstd_parser_parse_cmd_async()
+ */
+typedef void (*GstdParserReadyFunc) (GstdReturnCode ret, gchar * response,
+    gpointer user_data);
+
+/**
+ * gstd_parser_parse_cmd_async:
+ * @session: The session the command operates on
+ * @cmd: A command such as "bus_read p0"
+ * @cancellable: (nullable): Abandons commands that are still waiting
+ * @func: Called with the result once the command completes
+ * @user_data: Data passed to @func
+ *
+ * Executes a command like gstd_parser_parse_cmd(). Commands that wait,
+ * such as bus reads, don't block the calling thread, @func is called
+ * later from whichever thread completes them. Every other command
+ * completes before this function returns.
+ */
+void gstd_parser_parse_cmd_async (GstdSession * session, const gchar * cmd,
+    GCancellable * cancellable, GstdParserReadyFunc func,
+    gpointer user_data);
+
+/**
+ * gstd_parser_envelope:
+ * @ret: The code returned by the command
+ * @output: (nullable): The serialized result of the command
+ * @id: (nullable): The request id supplied by the client
+ *
+ * Wraps the result of a command in the response sent back to clients,
+ * in the layout selected with gstd_object_set_pretty().
+ *
+ * Returns: (transfer full): The response. Free with g_free after usage
+ */
+gchar *gstd_parser_envelope (GstdReturnCode ret, const gchar * output,
+    const gchar * id);
+
+/**
+ * gstd_parser_bus_subscribe:
+ * @session: The session the pipeline belongs to
+ * @args: The "<pipeline> <filter>" arguments of bus_subscribe, where the
+ * filter has the same syntax as bus_filter, e.g. "error+warning+eos"
+ * @max_queued: Messages kept while the subscriber falls behind
+ * @notify: Wakes up the subscriber when messages are queued
+ * @user_data: Data passed to @notify
+ * @destroy: (nullable): Frees @user_data on unsubscribe
+ * @subscription: (out): Placeholder for the new subscription
+ *
+ * Subscribes to the bus of a pipeline, see gstd_pipeline_bus_subscribe().
+ * Used by IPCs able to push messages to their clients.
+ *
+ * Returns: A GstdReturnCode with the execution status
+ */
+GstdReturnCode gstd_parser_bus_subscribe (GstdSession * session,
+    gchar * args, guint max_queued, GstdPipelineBusNotify notify,
+    gpointer user_data, GDestroyNotify destroy,
+    GstdPipelineBusSubscription ** subscription);
+
+/**
+ * gstd_parser_bus_event:
+ * @message: The message pushed to the subscriber
+ * @dropped: The messages dropped so far for this subscriber
+ *
+ * Serializes a pushed bus message like a bus_read response, with the
+ * drop counter added to the envelope.
+ *
+ * Returns: (transfer full): The event. Free with g_free after usage
+ */
+gchar *gstd_parser_bus_event (GstMessage * message, guint dropped);
+
+/**
+ * gstd_parser_watch:
+ * @session: The session the property belongs to
+ * @args: The "<uri> [interval=<ms>] [period=<ms>] [deadband=<delta>]"
+ * arguments of watch, where the URI points to a property such as
+ * "/pipelines/p0/elements/q0/properties/current-level-buffers"
+ * @context: (nullable): The main context @func is called from
+ * @func: Called with every change of the property
+ * @user_data: Data passed to @func
+ * @destroy: (nullable): Frees @user_data on unwatch
+ * @watch: (out): Placeholder for the new watch
+ *
+ * Watches a property, see gstd_property_watch(). Used by IPCs able to
+ * push updates to their clients.
+ *
+ * Returns: A GstdReturnCode with the execution status
+ */
+GstdReturnCode gstd_parser_watch (GstdSession * session, gchar * args,
+    GMainContext * context, GstdPropertyWatchFunc func, gpointer user_data,
+    GDestroyNotify destroy, GstdPropertyWatch ** watch);
+
+/**
+ * gstd_parser_watch_event:
+ * @uri: The URI the client watched
+ * @watch: The watch whose property changed
+ *
+ * Serializes the name and value of a watched property like an
+ * element_get response, with the URI added to the envelope.
+ *
+ * Returns: (transfer full): The event. Free with g_free after usage
+ */
+gchar *gstd_parser_watch_event (const gchar * uri, GstdPropertyWatch * watch);
+
+G_END_DECLS
+#endif //__GSTD_PARSER_H__
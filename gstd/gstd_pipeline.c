@@ -31,8 +31,10 @@
 #include "gstd_event_handler.h"
 #include "gstd_pipeline_bus.h"
 #include "gstd_list_reader.h"
+#include "gstd_property.h"
 #include "gstd_property_reader.h"
 #include "gstd_state.h"
+#include "gstd_schema.h"
 
 enum
 {
@@ -179,9 +181,9 @@ gstd_pipeline_init (GstdPipeline * self)
       "node-type", GSTD_TYPE_ELEMENT, "flags", GSTD_PARAM_READ, NULL);
 
   gstd_object_set_reader (GSTD_OBJECT(self->elements),
-      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+      gstd_object_get_strategy (GSTD_TYPE_LIST_READER));
   gstd_object_set_reader (GSTD_OBJECT(self),
-      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+      gstd_object_get_strategy (GSTD_TYPE_PROPERTY_READER));
 }
 
 GstdReturnCode
@@ -479,3 +481,68 @@ noiter:
     return GSTD_NO_PIPELINE;
   }
 }
+
+/* Adds the member describing the given properties of element */
+static void
+gstd_pipeline_snapshot_element (GstdIFormatter * formatter,
+    GstElement * element, gchar ** names)
+{
+  const GstdSchema *schema;
+  const GstdSchemaProperty *property;
+  GValue value = G_VALUE_INIT;
+  guint i;
+
+  schema = gstd_schema_get (G_OBJECT_TYPE (element));
+
+  gstd_iformatter_set_member_name (formatter, GST_OBJECT_NAME (element));
+  gstd_iformatter_begin_object (formatter);
+
+  for (i = 0; names ? NULL != names[i] : i < schema->n_properties; i++) {
+    property = names ? gstd_schema_find (schema, names[i]) :
+        &schema->properties[i];
+    if (!property || !(property->pspec->flags & G_PARAM_READABLE)) {
+      continue;
+    }
+
+    g_value_init (&value, property->pspec->value_type);
+    g_object_get_property (G_OBJECT (element), property->pspec->name, &value);
+
+    gstd_iformatter_set_member_name (formatter, property->pspec->name);
+    gstd_property_format_value (property->pspec, formatter, &value);
+    g_value_unset (&value);
+  }
+
+  gstd_iformatter_end_object (formatter);
+}
+
+GstdReturnCode
+gstd_pipeline_snapshot (GstdPipeline * self, gchar ** names,
+    gchar ** outstring)
+{
+  GstdIFormatter *formatter;
+  GstElement *element;
+  GList *node;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (outstring, GSTD_NULL_ARGUMENT);
+  g_warn_if_fail (!*outstring);
+
+  /* One formatter describes every element */
+  gstd_object_formatter_acquire (GSTD_OBJECT (self));
+  formatter = GSTD_OBJECT (self)->formatter;
+
+  gstd_iformatter_begin_object (formatter);
+
+  for (node = self->elements->list->head; node; node = node->next) {
+    g_object_get (node->data, "gstelement", &element, NULL);
+    gstd_pipeline_snapshot_element (formatter, element, names);
+    gst_object_unref (element);
+  }
+
+  gstd_iformatter_end_object (formatter);
+
+  gstd_iformatter_generate (formatter, outstring);
+  gstd_object_formatter_release (GSTD_OBJECT (self), TRUE);
+
+  return GSTD_EOK;
+}
@@ -46,5 +46,22 @@ GType gstd_pipeline_get_type ();
 
 GstdReturnCode gstd_pipeline_build (GstdPipeline * object);
 
+/**
+ * gstd_pipeline_snapshot:
+ * @self: The pipeline to describe
+ * @names: (nullable): A NULL terminated list of property names, NULL for
+ * every readable property
+ * @outstring: Placeholder for the serialized snapshot, must be NULL. Free
+ * with g_free after usage
+ *
+ * Serializes the current value of the given properties of every element
+ * of @self as a single { "element" : { "property" : value } } object.
+ * Elements lacking a property simply leave it out.
+ *
+ * Returns: A GstdReturnCode with the execution status
+ */
+GstdReturnCode gstd_pipeline_snapshot (GstdPipeline * self,
+    gchar ** names, gchar ** outstring);
+
 G_END_DECLS
 #endif // __GSTD_PIPELINE_H__
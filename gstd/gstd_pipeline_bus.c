@@ -20,6 +20,8 @@
 #ifdef HAVE_CONFIG_H
 #include "config.h"
 #endif
+#include <glib-unix.h>
+
 #include "gstd_pipeline_bus.h"
 #include "gstd_msg_reader.h"
 #include "gstd_msg_type.h"
@@ -41,6 +43,24 @@ struct _GstdPipelineBus
   gint64 timeout;
   gint types;
 
+  /* Subscriptions fed from the bus sync handler */
+  GMutex lock;
+  GList *subscriptions;
+};
+
+/* A subscriber's bounded queue. Messages arriving while it is full are
+ * dropped and counted */
+struct _GstdPipelineBusSubscription
+{
+  GstdPipelineBus *self;
+  gint types;
+  guint max_queued;
+  GQueue queue;
+  guint dropped;
+  gboolean notified;
+  GstdPipelineBusNotify notify;
+  gpointer user_data;
+  GDestroyNotify destroy;
 };
 
 struct _GstdPipelineBusClass
@@ -54,6 +74,40 @@ static void
 gstd_pipeline_bus_get_property (GObject * object,
   guint property_id, GValue * value, GParamSpec * pspec);
 static void gstd_pipeline_bus_dispose (GObject *);
+static void gstd_pipeline_bus_finalize (GObject *);
+static GstBusSyncReply gstd_pipeline_bus_sync_handler (GstBus * bus,
+    GstMessage * message, gpointer user_data);
+
+/* A bus read parked until a message arrives, the timeout expires or the
+ * read is cancelled. Only touched from the waiter thread once handed
+ * over to it */
+typedef struct _GstdPipelineBusWait
+{
+  GstdPipelineBus *self;
+  GstBus *bus;
+  gint types;
+  gint64 timeout;
+  GCancellable *cancellable;
+  gboolean flushing;
+  GSource *bus_source;
+  GSource *timeout_source;
+  GSource *cancel_source;
+  GstdPipelineBusFunc func;
+  gpointer user_data;
+} GstdPipelineBusWait;
+
+#if GST_CHECK_VERSION (1, 14, 0)
+static GMainContext *gstd_pipeline_bus_waiter_context (void);
+static gpointer gstd_pipeline_bus_waiter (gpointer user_data);
+static void gstd_pipeline_bus_wait_finish (GstdPipelineBusWait * wait,
+    GstMessage * message);
+static gboolean gstd_pipeline_bus_wait_park (gpointer user_data);
+static gboolean gstd_pipeline_bus_wait_message (gint fd,
+    GIOCondition condition, gpointer user_data);
+static gboolean gstd_pipeline_bus_wait_timeout (gpointer user_data);
+static gboolean gstd_pipeline_bus_wait_cancelled (GCancellable * cancellable,
+    gpointer user_data);
+#endif
 
 G_DEFINE_TYPE (GstdPipelineBus, gstd_pipeline_bus, GSTD_TYPE_OBJECT);
 
@@ -75,6 +129,7 @@ gstd_pipeline_bus_class_init (GstdPipelineBusClass * klass)
   object_class->set_property = gstd_pipeline_bus_set_property;
   object_class->get_property = gstd_pipeline_bus_get_property;
   object_class->dispose = gstd_pipeline_bus_dispose;
+  object_class->finalize = gstd_pipeline_bus_finalize;
 
   properties[PROP_MESSAGE] =
     g_param_spec_object ("message",
@@ -115,9 +170,11 @@ gstd_pipeline_bus_init (GstdPipelineBus * self)
 
   self->timeout = GSTD_PIPELINE_BUS_TIMEOUT_DEFAULT;
   self->types = GSTD_PIPELINE_BUS_TYPES_DEFAULT;
+  self->subscriptions = NULL;
+  g_mutex_init (&self->lock);
 
   gstd_object_set_reader (GSTD_OBJECT(self),
-      g_object_new (GSTD_TYPE_MSG_READER, NULL));
+      gstd_object_get_strategy (GSTD_TYPE_MSG_READER));
 }
 
 
@@ -131,6 +188,10 @@ gstd_pipeline_bus_new (GstBus * bus)
   self = GSTD_PIPELINE_BUS (g_object_new (GSTD_TYPE_PIPELINE_BUS, NULL));
   self->bus = gst_object_ref (bus);
 
+  /* Messages are still queued for bus_read after subscribers get a
+   * copy */
+  gst_bus_set_sync_handler (bus, gstd_pipeline_bus_sync_handler, self, NULL);
+
   return self;
 }
 
@@ -190,11 +251,59 @@ gstd_pipeline_bus_dispose (GObject * object)
 
   GST_INFO_OBJECT (self, "Disposing %s pipeline bus", GSTD_OBJECT_NAME (self));
 
+  if (self->bus) {
+    gst_bus_set_sync_handler (GST_BUS (self->bus), NULL, NULL, NULL);
+  }
   g_clear_object(&self->bus);
 
   G_OBJECT_CLASS (gstd_pipeline_bus_parent_class)->dispose (object);
 }
 
+static void
+gstd_pipeline_bus_finalize (GObject * object)
+{
+  GstdPipelineBus *self = GSTD_PIPELINE_BUS (object);
+
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (gstd_pipeline_bus_parent_class)->finalize (object);
+}
+
+/* Runs in whichever thread posted the message */
+static GstBusSyncReply
+gstd_pipeline_bus_sync_handler (GstBus * bus, GstMessage * message,
+    gpointer user_data)
+{
+  GstdPipelineBus *self = user_data;
+  GstdPipelineBusSubscription *sub;
+  GList *l;
+
+  g_mutex_lock (&self->lock);
+  for (l = self->subscriptions; l; l = l->next) {
+    sub = l->data;
+
+    if (!(GST_MESSAGE_TYPE (message) & sub->types)) {
+      continue;
+    }
+
+    if (g_queue_get_length (&sub->queue) >= sub->max_queued) {
+      sub->dropped++;
+      continue;
+    }
+
+    g_queue_push_tail (&sub->queue, gst_message_ref (message));
+
+    /* A single wake up per batch, the subscriber pops until empty */
+    if (!sub->notified) {
+      sub->notified = TRUE;
+      sub->notify (sub, sub->user_data);
+    }
+  }
+  g_mutex_unlock (&self->lock);
+
+  return GST_BUS_PASS;
+}
+
 GstBus *
 gstd_pipeline_bus_get_bus (GstdPipelineBus *self)
 {
@@ -203,3 +312,272 @@ gstd_pipeline_bus_get_bus (GstdPipelineBus *self)
   return gst_object_ref (self->bus);
 }
 
+#if GST_CHECK_VERSION (1, 14, 0)
+static gpointer
+gstd_pipeline_bus_waiter (gpointer user_data)
+{
+  GMainLoop *loop = user_data;
+
+  g_main_context_push_thread_default (g_main_loop_get_context (loop));
+  g_main_loop_run (loop);
+
+  return NULL;
+}
+
+/* Every parked read is served from a single thread, so waiting clients
+ * don't cost a thread each */
+static GMainContext *
+gstd_pipeline_bus_waiter_context (void)
+{
+  static gsize context = 0;
+  GMainContext *new;
+
+  if (g_once_init_enter (&context)) {
+    new = g_main_context_new ();
+    g_thread_unref (g_thread_new ("gstd-bus", gstd_pipeline_bus_waiter,
+            g_main_loop_new (new, FALSE)));
+    g_once_init_leave (&context, (gsize) new);
+  }
+
+  return (GMainContext *) context;
+}
+
+static void
+gstd_pipeline_bus_wait_finish (GstdPipelineBusWait * wait,
+    GstMessage * message)
+{
+  GSource **sources[] =
+      { &wait->bus_source, &wait->timeout_source, &wait->cancel_source };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (sources); i++) {
+    if (*sources[i]) {
+      g_source_destroy (*sources[i]);
+      g_source_unref (*sources[i]);
+      *sources[i] = NULL;
+    }
+  }
+
+  if (wait->flushing) {
+    gst_bus_set_flushing (wait->bus, FALSE);
+  }
+
+  wait->func (wait->self, message, wait->user_data);
+
+  if (wait->cancellable) {
+    g_object_unref (wait->cancellable);
+  }
+  gst_object_unref (wait->bus);
+  g_object_unref (wait->self);
+  g_slice_free (GstdPipelineBusWait, wait);
+}
+
+static gboolean
+gstd_pipeline_bus_wait_message (gint fd, GIOCondition condition,
+    gpointer user_data)
+{
+  GstdPipelineBusWait *wait = user_data;
+  GstMessage *message;
+
+  /* Other reads on the same bus may have taken the message first,
+   * messages not matching the filter are dropped as with blocking reads */
+  message = gst_bus_pop_filtered (wait->bus, wait->types);
+  if (message) {
+    gstd_pipeline_bus_wait_finish (wait, message);
+    return G_SOURCE_REMOVE;
+  }
+
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+gstd_pipeline_bus_wait_timeout (gpointer user_data)
+{
+  GstdPipelineBusWait *wait = user_data;
+
+  gstd_pipeline_bus_wait_finish (wait, NULL);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+gstd_pipeline_bus_wait_cancelled (GCancellable * cancellable,
+    gpointer user_data)
+{
+  GstdPipelineBusWait *wait = user_data;
+
+  GST_DEBUG_OBJECT (wait->self, "Bus read cancelled");
+  gstd_pipeline_bus_wait_finish (wait, NULL);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* Runs in the waiter thread, so the wait can't complete while it is
+ * being set up */
+static gboolean
+gstd_pipeline_bus_wait_park (gpointer user_data)
+{
+  GstdPipelineBusWait *wait = user_data;
+  GMainContext *context = g_main_context_get_thread_default ();
+  GPollFD pollfd;
+  guint64 timeout_ms;
+
+  if (GST_MESSAGE_UNKNOWN == wait->types) {
+    GST_INFO_OBJECT (wait->self, "Flushing the bus for %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (wait->timeout));
+    wait->flushing = TRUE;
+    gst_bus_set_flushing (wait->bus, TRUE);
+  } else {
+    gst_bus_get_pollfd (wait->bus, &pollfd);
+    wait->bus_source = g_unix_fd_source_new (pollfd.fd, G_IO_IN);
+    g_source_set_callback (wait->bus_source,
+        (GSourceFunc) gstd_pipeline_bus_wait_message, wait, NULL);
+    g_source_attach (wait->bus_source, context);
+  }
+
+  if (wait->timeout > 0) {
+    timeout_ms = (wait->timeout + GST_MSECOND - 1) / GST_MSECOND;
+    wait->timeout_source = g_timeout_source_new (MIN (timeout_ms, G_MAXUINT));
+    g_source_set_callback (wait->timeout_source,
+        gstd_pipeline_bus_wait_timeout, wait, NULL);
+    g_source_attach (wait->timeout_source, context);
+  }
+
+  if (wait->cancellable) {
+    wait->cancel_source = g_cancellable_source_new (wait->cancellable);
+    g_source_set_callback (wait->cancel_source,
+        (GSourceFunc) gstd_pipeline_bus_wait_cancelled, wait, NULL);
+    g_source_attach (wait->cancel_source, context);
+  }
+
+  return G_SOURCE_REMOVE;
+}
+#endif
+
+void
+gstd_pipeline_bus_read_async (GstdPipelineBus * self,
+    GCancellable * cancellable, GstdPipelineBusFunc func, gpointer user_data)
+{
+  GstMessage *message = NULL;
+
+  g_return_if_fail (GSTD_IS_PIPELINE_BUS (self));
+  g_return_if_fail (func);
+
+  /* The unknown or none message type is not a valid polling filter,
+   * instead we interpret it as a flushing request. As such we flush
+   * the bus for "timeout" nanoseconds
+   */
+  if (GST_MESSAGE_UNKNOWN != self->types) {
+    message = gst_bus_pop_filtered (GST_BUS (self->bus), self->types);
+  }
+
+  if (message || 0 == self->timeout) {
+    func (self, message, user_data);
+    return;
+  }
+
+#if GST_CHECK_VERSION (1, 14, 0)
+  GstdPipelineBusWait *wait;
+
+  wait = g_slice_new0 (GstdPipelineBusWait);
+  wait->self = g_object_ref (self);
+  wait->bus = gst_object_ref (self->bus);
+  wait->types = self->types;
+  wait->timeout = self->timeout;
+  wait->cancellable = cancellable ? g_object_ref (cancellable) : NULL;
+  wait->func = func;
+  wait->user_data = user_data;
+
+  g_main_context_invoke (gstd_pipeline_bus_waiter_context (),
+      gstd_pipeline_bus_wait_park, wait);
+#else
+  /* Without access to the bus file descriptor the wait has to block */
+  if (GST_MESSAGE_UNKNOWN == self->types) {
+    gst_bus_set_flushing (GST_BUS (self->bus), TRUE);
+    g_usleep (GST_TIME_AS_USECONDS (self->timeout));
+    gst_bus_set_flushing (GST_BUS (self->bus), FALSE);
+  } else {
+    message = gst_bus_timed_pop_filtered (GST_BUS (self->bus), self->timeout,
+        self->types);
+  }
+  func (self, message, user_data);
+#endif
+}
+
+GstdPipelineBusSubscription *
+gstd_pipeline_bus_subscribe (GstdPipelineBus * self, gint types,
+    guint max_queued, GstdPipelineBusNotify notify, gpointer user_data,
+    GDestroyNotify destroy)
+{
+  GstdPipelineBusSubscription *sub;
+
+  g_return_val_if_fail (GSTD_IS_PIPELINE_BUS (self), NULL);
+  g_return_val_if_fail (max_queued > 0, NULL);
+  g_return_val_if_fail (notify, NULL);
+
+  sub = g_slice_new0 (GstdPipelineBusSubscription);
+  sub->self = g_object_ref (self);
+  sub->types = types;
+  sub->max_queued = max_queued;
+  g_queue_init (&sub->queue);
+  sub->notify = notify;
+  sub->user_data = user_data;
+  sub->destroy = destroy;
+
+  g_mutex_lock (&self->lock);
+  self->subscriptions = g_list_prepend (self->subscriptions, sub);
+  g_mutex_unlock (&self->lock);
+
+  GST_INFO_OBJECT (self, "New subscription for types 0x%x", types);
+
+  return sub;
+}
+
+GstMessage *
+gstd_pipeline_bus_subscription_pop (GstdPipelineBusSubscription * sub,
+    guint * dropped)
+{
+  GstdPipelineBus *self;
+  GstMessage *message;
+
+  g_return_val_if_fail (sub, NULL);
+
+  self = sub->self;
+
+  g_mutex_lock (&self->lock);
+  message = g_queue_pop_head (&sub->queue);
+  if (!message) {
+    sub->notified = FALSE;
+  }
+  if (dropped) {
+    *dropped = sub->dropped;
+  }
+  g_mutex_unlock (&self->lock);
+
+  return message;
+}
+
+void
+gstd_pipeline_bus_unsubscribe (GstdPipelineBusSubscription * sub)
+{
+  GstdPipelineBus *self;
+
+  g_return_if_fail (sub);
+
+  self = sub->self;
+
+  g_mutex_lock (&self->lock);
+  self->subscriptions = g_list_remove (self->subscriptions, sub);
+  g_mutex_unlock (&self->lock);
+
+  GST_INFO_OBJECT (self, "Subscription removed, %u messages dropped",
+      sub->dropped);
+
+  g_queue_foreach (&sub->queue, (GFunc) gst_message_unref, NULL);
+  g_queue_clear (&sub->queue);
+  if (sub->destroy) {
+    sub->destroy (sub->user_data);
+  }
+  g_object_unref (self);
+  g_slice_free (GstdPipelineBusSubscription, sub);
+}
@@ -21,6 +21,7 @@
 #define __GSTD_PIPELINE_BUS_H__
 
 #include <gst/gst.h>
+#include <gio/gio.h>
 #include <gstd_object.h>
 
 G_BEGIN_DECLS
@@ -57,6 +58,94 @@ GstdPipelineBus *gstd_pipeline_bus_new (GstBus* bus);
 GstBus *
 gstd_pipeline_bus_get_bus (GstdPipelineBus *self);
 
+/**
+ * GstdPipelineBusFunc:
+ * @self: The pipeline bus that was read
+ * @message: (transfer full) (nullable): The message read, NULL if none
+ * arrived before the timeout or the read was cancelled
+ * @user_data: The data passed to gstd_pipeline_bus_read_async()
+ */
+typedef void (*GstdPipelineBusFunc) (GstdPipelineBus * self,
+    GstMessage * message, gpointer user_data);
+
+/**
+ * gstd_pipeline_bus_read_async:
+ * @self: The pipeline bus to read from
+ * @cancellable: (nullable): Cancels the read
+ * @func: Called with the message once the read completes
+ * @user_data: Data passed to @func
+ *
+ * Reads a message matching the current types, waiting for the current
+ * timeout, without blocking the calling thread. If a message is already
+ * queued or the timeout is 0, @func is called right away from the
+ * calling thread. Otherwise it is called later from the thread shared
+ * by every pending bus read.
+ */
+void
+gstd_pipeline_bus_read_async (GstdPipelineBus * self,
+    GCancellable * cancellable, GstdPipelineBusFunc func, gpointer user_data);
+
+typedef struct _GstdPipelineBusSubscription GstdPipelineBusSubscription;
+
+/**
+ * GstdPipelineBusNotify:
+ * @sub: The subscription with new messages
+ * @user_data: The data passed to gstd_pipeline_bus_subscribe()
+ *
+ * Called from the thread posting the message, with the bus lock held,
+ * once the subscription queue stops being empty. Must not block nor
+ * call back into the bus.
+ */
+typedef void (*GstdPipelineBusNotify) (GstdPipelineBusSubscription * sub,
+    gpointer user_data);
+
+/**
+ * gstd_pipeline_bus_subscribe:
+ * @self: The pipeline bus to subscribe to
+ * @types: The #GstMessageType flags to receive
+ * @max_queued: Messages kept while the subscriber falls behind, newer
+ * ones are dropped
+ * @notify: Wakes up the subscriber when messages are queued
+ * @user_data: Data passed to @notify
+ * @destroy: (nullable): Frees @user_data on unsubscribe
+ *
+ * Receives a copy of every matching message posted from now on. Unlike
+ * bus_read this doesn't take messages off the bus, so subscribers don't
+ * compete with each other nor with readers.
+ *
+ * Returns: (transfer full): The subscription, release it with
+ * gstd_pipeline_bus_unsubscribe()
+ */
+GstdPipelineBusSubscription *
+gstd_pipeline_bus_subscribe (GstdPipelineBus * self, gint types,
+    guint max_queued, GstdPipelineBusNotify notify, gpointer user_data,
+    GDestroyNotify destroy);
+
+/**
+ * gstd_pipeline_bus_subscription_pop:
+ * @sub: The subscription to read from
+ * @dropped: (out) (optional): Messages dropped so far
+ *
+ * Takes the oldest queued message. Once it returns NULL the next
+ * queued message notifies the subscriber again.
+ *
+ * Returns: (transfer full) (nullable): The message, NULL if the queue
+ * is empty
+ */
+GstMessage *
+gstd_pipeline_bus_subscription_pop (GstdPipelineBusSubscription * sub,
+    guint * dropped);
+
+/**
+ * gstd_pipeline_bus_unsubscribe:
+ * @sub: The subscription to release
+ *
+ * Stops the subscription and frees it along with its queue. @notify is
+ * not called anymore once this returns.
+ */
+void
+gstd_pipeline_bus_unsubscribe (GstdPipelineBusSubscription * sub);
+
 
 G_END_DECLS
 #endif // __GSTD_PIPELINE_BUS_H__
@@ -22,6 +22,11 @@
 #endif
 
 #include "gstd_property.h"
+#include "gstd_property_boolean.h"
+#include "gstd_property_enum.h"
+#include "gstd_property_flags.h"
+#include "gstd_property_int.h"
+#include "gstd_property_string.h"
 
 enum {
     PROP_TARGET = 1,
@@ -57,6 +62,11 @@ gstd_property_add_value_default (GstdProperty * self, GstdIFormatter * formatter
     GValue * value);
 static GstdReturnCode
 gstd_property_update_default (GstdObject * object, const gchar * arg);
+static GstdReturnCode
+gstd_property_parse_default (GParamSpec * pspec, const gchar * svalue,
+    GValue * value);
+static gboolean
+gstd_property_is_cacheable (GstdObject * object);
 
 static void
 gstd_property_class_init (GstdPropertyClass *klass)
@@ -87,8 +97,10 @@ gstd_property_class_init (GstdPropertyClass *klass)
 
   gstdc->to_string = GST_DEBUG_FUNCPTR(gstd_property_to_string);
   gstdc->update = GST_DEBUG_FUNCPTR(gstd_property_update_default);
+  gstdc->is_cacheable = GST_DEBUG_FUNCPTR(gstd_property_is_cacheable);
 
   klass->add_value = GST_DEBUG_FUNCPTR(gstd_property_add_value_default);
+  klass->parse = GST_DEBUG_FUNCPTR(gstd_property_parse_default);
 
   /* Initialize debug category with nice colors */
   debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
@@ -102,6 +114,13 @@ gstd_property_init (GstdProperty *self)
 {
   GST_INFO_OBJECT(self, "Initializing property");
   self->target = DEFAULT_PROP_TARGET;
+  self->owned = FALSE;
+}
+
+static gboolean
+gstd_property_is_cacheable (GstdObject * object)
+{
+  return GSTD_PROPERTY (object)->owned;
 }
 
 static void
@@ -165,91 +184,91 @@ gstd_property_set_property (GObject      *object,
 static GstdReturnCode
 gstd_property_to_string (GstdObject * obj, gchar ** outstring)
 {
-  GParamSpec * property;
-  GstdProperty * self;
-  GstdPropertyClass * klass;
-  GValue value = G_VALUE_INIT;
-  gchar *sflags;
-  const gchar *typename;
+  GstdReturnCode ret;
 
   g_return_val_if_fail (GSTD_IS_OBJECT (obj), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (outstring, GSTD_NULL_ARGUMENT);
 
-  self = GSTD_PROPERTY(obj);
-  klass = GSTD_PROPERTY_GET_CLASS(self);
-
-  property = g_object_class_find_property(G_OBJECT_GET_CLASS(self->target),
-      GSTD_OBJECT_NAME(self));
-
-  /* Describe each parameter using a structure */
-  gstd_iformatter_begin_object (obj->formatter);
-
-  gstd_iformatter_set_member_name (obj->formatter,"name");
-  gstd_iformatter_set_string_value (obj->formatter, property->name);
+  ret = gstd_property_format (GSTD_PROPERTY (obj), obj->formatter);
+  if (GSTD_EOK == ret) {
+    gstd_iformatter_generate (obj->formatter, outstring);
+  }
 
-  gstd_iformatter_set_member_name (obj->formatter,"value");
+  return ret;
+}
 
-  g_value_init (&value, property->value_type);
-  g_object_get_property (G_OBJECT(self->target), property->name, &value);
+GstdReturnCode
+gstd_property_format (GstdProperty * self, GstdIFormatter * formatter)
+{
+  const GstdSchemaProperty * schema;
+  GParamSpec * property;
+  GstdPropertyClass * klass;
+  GValue value = G_VALUE_INIT;
+  guint fields;
 
-  g_assert (klass->add_value);
-  klass->add_value (self, obj->formatter, &value);
+  g_return_val_if_fail (GSTD_IS_PROPERTY (self), GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (formatter, GSTD_NULL_ARGUMENT);
 
-  g_value_unset (&value);
+  klass = GSTD_PROPERTY_GET_CLASS(self);
+  fields = gstd_object_get_fields ();
 
-  gstd_iformatter_set_member_name (obj->formatter, "param_spec");
-  /* Describe the parameter specs using a structure */
-  gstd_iformatter_begin_object (obj->formatter);
+  schema = gstd_schema_find (gstd_schema_get (G_OBJECT_TYPE (self->target)),
+      GSTD_OBJECT_NAME(self));
+  g_return_val_if_fail (schema, GSTD_NO_RESOURCE);
+  property = schema->pspec;
 
-  gstd_iformatter_set_member_name (obj->formatter, "blurb");
-  gstd_iformatter_set_string_value (obj->formatter,property->_blurb);
+  /* Describe each parameter using a structure */
+  gstd_iformatter_begin_object (formatter);
 
-  typename = g_type_name (property->value_type);
-  gstd_iformatter_set_member_name (obj->formatter, "type");
-  gstd_iformatter_set_string_value (obj->formatter,typename);
+  if (fields & GSTD_FIELD_NAME) {
+    gstd_iformatter_set_member_name (formatter,"name");
+    gstd_iformatter_set_string_value (formatter, property->name);
+  }
 
-  g_value_init (&value, GSTD_TYPE_PARAM_FLAGS);
-  g_value_set_flags (&value, property->flags);
-  sflags = g_strdup_value_contents(&value);
-  g_value_unset (&value);
+  if (fields & GSTD_FIELD_VALUE) {
+    gstd_iformatter_set_member_name (formatter,"value");
 
-  gstd_iformatter_set_member_name (obj->formatter, "access");
-  gstd_iformatter_set_string_value (obj->formatter, sflags);
+    g_value_init (&value, property->value_type);
+    g_object_get_property (G_OBJECT(self->target), property->name, &value);
 
-  g_free (sflags);
+    g_assert (klass->add_value);
+    klass->add_value (self, formatter, &value);
 
-  gstd_iformatter_set_member_name (obj->formatter, "construct");
-  g_value_init (&value, G_TYPE_BOOLEAN);
-  g_value_set_boolean (&value, GSTD_PARAM_IS_DELETE(property->flags));
-  gstd_iformatter_set_value (obj->formatter, &value);
-  g_value_unset (&value);
+    g_value_unset (&value);
+  }
 
-  /* Close parameter specs structure */
-  gstd_iformatter_end_object (obj->formatter);
+  gstd_object_format_param_spec (formatter, schema);
 
   /* Close parameter structure */
-  gstd_iformatter_end_object (obj->formatter);
-
-  gstd_iformatter_generate (obj->formatter, outstring);
+  gstd_iformatter_end_object (formatter);
 
   return GSTD_EOK;
 }
 
+/* Floating point numbers are native in binary formats, everything else
+ * is serialized */
 static void
 gstd_property_add_value_default (GstdProperty * self, GstdIFormatter * formatter,
     GValue * value)
 {
   gchar * svalue;
 
-  g_return_if_fail (self);
   g_return_if_fail (formatter);
   g_return_if_fail (value);
 
+  if (gstd_object_get_binary () && (G_VALUE_HOLDS_FLOAT (value) ||
+          G_VALUE_HOLDS_DOUBLE (value))) {
+    gstd_iformatter_set_value (formatter, value);
+    return;
+  }
+
   svalue = gst_value_serialize (value);
   gstd_iformatter_set_string_value (formatter, svalue);
   g_free (svalue);
 }
 
+/* Parses the value with the class of the node, so updates through the
+ * node and through gstd_property_parse_value() accept the same values */
 static GstdReturnCode
 gstd_property_update_default (GstdObject * object, const gchar * svalue)
 {
@@ -263,17 +282,343 @@ gstd_property_update_default (GstdObject * object, const gchar * svalue)
 
   prop = GSTD_PROPERTY (object);
 
-  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS(prop->target),
-      GSTD_OBJECT_NAME(prop));
+  pspec = gstd_property_get_pspec (prop);
+  g_return_val_if_fail (pspec, GSTD_MISSING_INITIALIZATION);
 
-  g_value_init(&value, pspec->value_type);
+  g_value_init (&value, pspec->value_type);
 
-  if (!gst_value_deserialize (&value, svalue)) {
-    ret = GSTD_BAD_VALUE;
+  ret = GSTD_PROPERTY_GET_CLASS (prop)->parse (pspec, svalue, &value);
+  if (ret) {
+    GST_ERROR_OBJECT (object, "Cannot update %s: \"%s\" is not a valid %s",
+        pspec->name, svalue, g_type_name (pspec->value_type));
   } else {
     g_object_set_property (prop->target, pspec->name, &value);
-    ret = GSTD_EOK;
   }
 
+  g_value_unset (&value);
+
+  return ret;
+}
+
+/* Anything gst_value_deserialize() takes, as long as the param spec
+ * accepts it as is */
+static GstdReturnCode
+gstd_property_parse_default (GParamSpec * pspec, const gchar * svalue,
+    GValue * value)
+{
+  if (!gst_value_deserialize (value, svalue)) {
+    return GSTD_BAD_VALUE;
+  }
+
+  /* Validating fixes the value up, any fix means it was out of range */
+  if (g_param_value_validate (pspec, value)) {
+    return GSTD_BAD_VALUE;
+  }
+
+  return GSTD_EOK;
+}
+
+GstdReturnCode
+gstd_property_parse_value (GParamSpec * pspec, const gchar * svalue,
+    GValue * value)
+{
+  GstdPropertyClass * klass;
+  GstdReturnCode ret;
+
+  g_return_val_if_fail (pspec, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (svalue, GSTD_NULL_ARGUMENT);
+  g_return_val_if_fail (G_VALUE_HOLDS (value, pspec->value_type),
+      GSTD_NULL_ARGUMENT);
+
+  klass = g_type_class_ref (gstd_property_node_type (pspec));
+  ret = klass->parse (pspec, svalue, value);
+  g_type_class_unref (klass);
+
   return ret;
 }
+
+void
+gstd_property_format_value (GParamSpec * pspec, GstdIFormatter * formatter,
+    GValue * value)
+{
+  GstdPropertyClass * klass;
+
+  g_return_if_fail (pspec);
+  g_return_if_fail (formatter);
+  g_return_if_fail (value);
+
+  klass = g_type_class_ref (gstd_property_node_type (pspec));
+  klass->add_value (NULL, formatter, value);
+  g_type_class_unref (klass);
+}
+
+GType
+gstd_property_node_type (GParamSpec * pspec)
+{
+  g_return_val_if_fail (pspec, GSTD_TYPE_PROPERTY);
+
+  switch (pspec->value_type) {
+    case G_TYPE_BOOLEAN:
+      return GSTD_TYPE_PROPERTY_BOOLEAN;
+    case G_TYPE_INT:
+    case G_TYPE_UINT:
+    case G_TYPE_INT64:
+    case G_TYPE_UINT64:
+      return GSTD_TYPE_PROPERTY_INT;
+    case G_TYPE_STRING:
+      return GSTD_TYPE_PROPERTY_STRING;
+    default:
+      break;
+  }
+
+  if (G_TYPE_IS_ENUM (pspec->value_type)) {
+    return GSTD_TYPE_PROPERTY_ENUM;
+  } else if (G_TYPE_IS_FLAGS (pspec->value_type)) {
+    return GSTD_TYPE_PROPERTY_FLAGS;
+  }
+
+  return GSTD_TYPE_PROPERTY;
+}
+
+GParamSpec *
+gstd_property_get_pspec (GstdProperty * self)
+{
+  const GstdSchemaProperty *property;
+
+  g_return_val_if_fail (GSTD_IS_PROPERTY (self), NULL);
+  g_return_val_if_fail (self->target, NULL);
+
+  property = gstd_schema_find (gstd_schema_get (G_OBJECT_TYPE (self->target)),
+      GSTD_OBJECT_NAME (self));
+
+  return property ? property->pspec : NULL;
+}
+
+/* A watch is a source of the subscriber's main context. Notify handlers
+ * only schedule it, the value is read and compared when it dispatches */
+struct _GstdPropertyWatch
+{
+  GSource source;
+
+  GstdProperty *property;
+  GParamSpec *pspec;
+  gulong handler;
+
+  gint64 interval;
+  gint64 period;
+  gdouble deadband;
+
+  /* Guards the scheduling, notify is emitted from any thread */
+  GMutex lock;
+  gint64 ready;
+  gint64 reported;
+
+  GValue last;
+
+  GstdPropertyWatchFunc func;
+  gpointer user_data;
+  GDestroyNotify destroy;
+};
+
+/* Dispatches the watch at time, or earlier if it already is due then */
+static void
+gstd_property_watch_schedule (GstdPropertyWatch * watch, gint64 time)
+{
+  g_mutex_lock (&watch->lock);
+
+  /* Coalesce the changes within the interval */
+  time = MAX (time, watch->reported + watch->interval);
+
+  if (-1 == watch->ready || time < watch->ready) {
+    watch->ready = time;
+    g_source_set_ready_time ((GSource *) watch, time);
+  }
+
+  g_mutex_unlock (&watch->lock);
+}
+
+static void
+gstd_property_watch_notify (GObject * target, GParamSpec * pspec,
+    gpointer user_data)
+{
+  gstd_property_watch_schedule (user_data, g_get_monotonic_time ());
+}
+
+static gboolean
+gstd_property_watch_to_double (const GValue * value, gdouble * number)
+{
+  GValue transformed = G_VALUE_INIT;
+
+  switch (G_TYPE_FUNDAMENTAL (G_VALUE_TYPE (value))) {
+    case G_TYPE_INT:
+    case G_TYPE_UINT:
+    case G_TYPE_LONG:
+    case G_TYPE_ULONG:
+    case G_TYPE_INT64:
+    case G_TYPE_UINT64:
+    case G_TYPE_FLOAT:
+    case G_TYPE_DOUBLE:
+      break;
+    default:
+      return FALSE;
+  }
+
+  g_value_init (&transformed, G_TYPE_DOUBLE);
+  g_value_transform (value, &transformed);
+  *number = g_value_get_double (&transformed);
+  g_value_unset (&transformed);
+
+  return TRUE;
+}
+
+/* Whether value differs enough from the last reported one */
+static gboolean
+gstd_property_watch_changed (GstdPropertyWatch * watch, const GValue * value)
+{
+  gdouble last, current;
+  gint cmp;
+
+  if (!G_IS_VALUE (&watch->last)) {
+    return TRUE;
+  }
+
+  if (gstd_property_watch_to_double (&watch->last, &last) &&
+      gstd_property_watch_to_double (value, &current)) {
+    return current != last && ABS (current - last) >= watch->deadband;
+  }
+
+  cmp = gst_value_compare (&watch->last, value);
+  if (GST_VALUE_UNORDERED == cmp) {
+    return 0 != g_param_values_cmp (watch->pspec, &watch->last, value);
+  }
+
+  return GST_VALUE_EQUAL != cmp;
+}
+
+static gboolean
+gstd_property_watch_dispatch (GSource * source, GSourceFunc callback,
+    gpointer user_data)
+{
+  GstdPropertyWatch *watch = (GstdPropertyWatch *) source;
+  GValue value = G_VALUE_INIT;
+  gint64 now = g_get_monotonic_time ();
+
+  g_mutex_lock (&watch->lock);
+  watch->ready = -1;
+  g_source_set_ready_time (source, -1);
+  g_mutex_unlock (&watch->lock);
+
+  g_value_init (&value, watch->pspec->value_type);
+  g_object_get_property (watch->property->target, watch->pspec->name,
+      &value);
+
+  if (gstd_property_watch_changed (watch, &value)) {
+    if (G_IS_VALUE (&watch->last)) {
+      g_value_unset (&watch->last);
+    }
+    g_value_init (&watch->last, watch->pspec->value_type);
+    g_value_copy (&value, &watch->last);
+
+    g_mutex_lock (&watch->lock);
+    watch->reported = now;
+    g_mutex_unlock (&watch->lock);
+
+    watch->func (watch, watch->user_data);
+  }
+  g_value_unset (&value);
+
+  if (watch->period) {
+    gstd_property_watch_schedule (watch, now + watch->period);
+  }
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+gstd_property_watch_finalize (GSource * source)
+{
+  GstdPropertyWatch *watch = (GstdPropertyWatch *) source;
+
+  if (G_IS_VALUE (&watch->last)) {
+    g_value_unset (&watch->last);
+  }
+  if (watch->destroy) {
+    watch->destroy (watch->user_data);
+  }
+  g_object_unref (watch->property);
+  g_mutex_clear (&watch->lock);
+}
+
+static GSourceFuncs gstd_property_watch_funcs = {
+  NULL, NULL, gstd_property_watch_dispatch, gstd_property_watch_finalize
+};
+
+GstdPropertyWatch *
+gstd_property_watch (GstdProperty * self, GMainContext * context,
+    guint interval, guint period, gdouble deadband,
+    GstdPropertyWatchFunc func, gpointer user_data, GDestroyNotify destroy)
+{
+  GstdPropertyWatch *watch;
+  GParamSpec *pspec;
+  gchar *signal;
+
+  g_return_val_if_fail (GSTD_IS_PROPERTY (self), NULL);
+  g_return_val_if_fail (func, NULL);
+
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (self->target),
+      GSTD_OBJECT_NAME (self));
+  g_return_val_if_fail (pspec, NULL);
+
+  watch = (GstdPropertyWatch *) g_source_new (&gstd_property_watch_funcs,
+      sizeof (GstdPropertyWatch));
+  watch->property = g_object_ref (self);
+  watch->pspec = pspec;
+  watch->interval = interval * G_TIME_SPAN_MILLISECOND;
+  watch->period = period * G_TIME_SPAN_MILLISECOND;
+  watch->deadband = deadband;
+  g_mutex_init (&watch->lock);
+  watch->ready = -1;
+  watch->reported = G_MININT64 / 2;
+  watch->func = func;
+  watch->user_data = user_data;
+  watch->destroy = destroy;
+
+  /* Handlers may still run in other threads after being disconnected,
+   * they keep their own reference */
+  signal = g_strdup_printf ("notify::%s", pspec->name);
+  watch->handler = g_signal_connect_data (self->target, signal,
+      G_CALLBACK (gstd_property_watch_notify), g_source_ref ((GSource *) watch),
+      (GClosureNotify) g_source_unref, 0);
+  g_free (signal);
+
+  g_source_attach ((GSource *) watch, context);
+
+  /* Start with the current value */
+  gstd_property_watch_schedule (watch, g_get_monotonic_time ());
+
+  GST_INFO_OBJECT (self, "Watching %s every %u ms at most", pspec->name,
+      interval);
+
+  return watch;
+}
+
+GstdProperty *
+gstd_property_watch_get_property (GstdPropertyWatch * watch)
+{
+  g_return_val_if_fail (watch, NULL);
+
+  return watch->property;
+}
+
+void
+gstd_property_unwatch (GstdPropertyWatch * watch)
+{
+  g_return_if_fail (watch);
+
+  GST_INFO_OBJECT (watch->property, "No longer watching %s",
+      watch->pspec->name);
+
+  g_signal_handler_disconnect (watch->property->target, watch->handler);
+  g_source_destroy ((GSource *) watch);
+  g_source_unref ((GSource *) watch);
+}
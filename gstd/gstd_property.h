@@ -51,15 +51,148 @@ struct _GstdProperty
   GstdObject parent;
 
   GObject * target;
+
+  /* Set by the list keeping the node. Nodes built for a single read,
+   * such as a list count, are not owned */
+  gboolean owned;
 };
 
 struct _GstdPropertyClass
 {
   GstdObjectClass parent_class;
 
+  /*
+   * Adds value to formatter, as a string in text formats. prop is NULL
+   * when the value is written by param spec alone, see
+   * gstd_property_format_value()
+   */
   void (* add_value) (GstdProperty * prop, GstdIFormatter * formatter, GValue * value);
+
+  /*
+   * Parses svalue into value, already initialized to the type of pspec.
+   * Returns GSTD_BAD_VALUE if it isn't a valid value of the property
+   */
+  GstdReturnCode (* parse) (GParamSpec * pspec, const gchar * svalue,
+      GValue * value);
 };
 
+/**
+ * gstd_property_node_type:
+ * @pspec: The param spec of a property
+ *
+ * Picks the #GstdProperty subclass for a property. Scalar types get one
+ * that parses and formats their values directly, everything else goes
+ * through gst_value_serialize() and gst_value_deserialize().
+ *
+ * Returns: The type of the node to create for the property
+ */
+GType gstd_property_node_type (GParamSpec * pspec);
+
+/**
+ * gstd_property_get_pspec:
+ * @self: A property
+ *
+ * Returns: (transfer none) (nullable): The param spec of the property,
+ * as found in the schema of its target
+ */
+GParamSpec *gstd_property_get_pspec (GstdProperty * self);
+
+/**
+ * gstd_property_format:
+ * @self: A property
+ * @formatter: The formatter to describe the property into
+ *
+ * Adds the property, as its to_string would describe it, as the next
+ * value of @formatter. Lets callers nest it into a larger document.
+ *
+ * Returns: GSTD_EOK, or an error if the property can't be described
+ */
+GstdReturnCode gstd_property_format (GstdProperty * self,
+    GstdIFormatter * formatter);
+
+/**
+ * gstd_property_format_value:
+ * @pspec: The param spec of the property @value was read from
+ * @formatter: The formatter to add @value to
+ * @value: The value to add
+ *
+ * Adds @value as the next value of @formatter, the same way the node of
+ * the property writes it: as a string in text formats and as a native
+ * value in binary ones for the types that have one.
+ */
+void gstd_property_format_value (GParamSpec * pspec,
+    GstdIFormatter * formatter, GValue * value);
+
+/**
+ * gstd_property_parse_value:
+ * @pspec: The param spec of the property
+ * @svalue: The value as given by the client
+ * @value: Holds the parsed value, must already be initialized to the
+ * type of @pspec
+ *
+ * Parses and range checks @svalue the same way updating the node of the
+ * property does, without setting anything.
+ *
+ * Returns: GSTD_EOK, or GSTD_BAD_VALUE if @svalue is not a valid value
+ * of the property
+ */
+GstdReturnCode gstd_property_parse_value (GParamSpec * pspec,
+    const gchar * svalue, GValue * value);
+
+typedef struct _GstdPropertyWatch GstdPropertyWatch;
+
+/**
+ * GstdPropertyWatchFunc:
+ * @watch: The watch whose property changed
+ * @user_data: The data passed to gstd_property_watch()
+ *
+ * Called from the watch's main context once the property changed.
+ */
+typedef void (*GstdPropertyWatchFunc) (GstdPropertyWatch * watch,
+    gpointer user_data);
+
+/**
+ * gstd_property_watch:
+ * @self: The property to watch
+ * @context: (nullable): The main context @func is called from
+ * @interval: Minimum milliseconds between calls, changes in between are
+ * coalesced into one
+ * @period: Milliseconds between samples, for properties that change
+ * without emitting notify, or 0 to rely on notify alone
+ * @deadband: Numeric properties only count as changed once they move
+ * further than this from the last reported value
+ * @func: Called with every change
+ * @user_data: Data passed to @func
+ * @destroy: (nullable): Frees @user_data on unwatch
+ *
+ * Reports the changes of the property from now on, starting with its
+ * current value. Changes are noticed through notify, so they cost
+ * nothing while the value stays the same.
+ *
+ * Returns: (transfer full): The watch, release it with
+ * gstd_property_unwatch()
+ */
+GstdPropertyWatch *gstd_property_watch (GstdProperty * self,
+    GMainContext * context, guint interval, guint period, gdouble deadband,
+    GstdPropertyWatchFunc func, gpointer user_data, GDestroyNotify destroy);
+
+/**
+ * gstd_property_watch_get_property:
+ * @watch: A watch
+ *
+ * Returns: (transfer none): The watched property
+ */
+GstdProperty *gstd_property_watch_get_property (GstdPropertyWatch * watch);
+
+/**
+ * gstd_property_unwatch:
+ * @watch: The watch to release
+ *
+ * Stops the watch. @func is not called anymore once this returns, as
+ * long as it is called from the watch's main context.
+ */
+void gstd_property_unwatch (GstdPropertyWatch * watch);
+
 G_END_DECLS
 
 #endif // __GSTD_PROPERTY_H__
@@ -38,16 +38,16 @@ static void
 gstd_property_boolean_add_value (GstdProperty * self, GstdIFormatter *formatter,
     GValue * value);
 static GstdReturnCode
-gstd_property_boolean_update (GstdObject * object, const gchar * value);
+gstd_property_boolean_parse (GParamSpec * pspec, const gchar * svalue,
+    GValue * value);
 
 static void
 gstd_property_boolean_class_init (GstdPropertyBooleanClass *klass)
 {
   guint debug_color;
   GstdPropertyClass *pclass = GSTD_PROPERTY_CLASS (klass);
-  GstdObjectClass *oclass = GSTD_OBJECT_CLASS (klass);
 
-  oclass->update = GST_DEBUG_FUNCPTR(gstd_property_boolean_update);
+  pclass->parse = GST_DEBUG_FUNCPTR(gstd_property_boolean_parse);
   pclass->add_value = GST_DEBUG_FUNCPTR(gstd_property_boolean_add_value);
 
   /* Initialize debug category with nice colors */
@@ -64,37 +64,36 @@ gstd_property_boolean_init (GstdPropertyBoolean *self)
 }
 
 
+/* Written as the strings gst_value_serialize() always produced in text
+ * formats, binary ones carry the boolean itself */
 static void
 gstd_property_boolean_add_value (GstdProperty * self, GstdIFormatter *formatter,
     GValue * value)
 {
-  gstd_iformatter_set_value (formatter, value);
+  if (gstd_object_get_binary ()) {
+    gstd_iformatter_set_value (formatter, value);
+    return;
+  }
+
+  gstd_iformatter_set_string_value (formatter,
+      g_value_get_boolean (value) ? "true" : "false");
 }
 
 static GstdReturnCode
-gstd_property_boolean_update (GstdObject * object, const gchar * value)
+gstd_property_boolean_parse (GParamSpec * pspec, const gchar * svalue,
+    GValue * value)
 {
-  GstdProperty *prop;
-  GstdReturnCode ret = GSTD_EOK;
-  gboolean bvalue;
-
-  g_return_val_if_fail (object, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (value, GSTD_NULL_ARGUMENT);
-
-  prop = GSTD_PROPERTY (object);
-  
-  if (0 == g_ascii_strcasecmp (value, "true") ||
-      0 == g_ascii_strcasecmp (value, "yes") ||
-      0 == g_strcmp0 (value, "1")) {
-    bvalue = TRUE;
-  } else if (0 == g_ascii_strcasecmp (value, "false") ||
-	     0 == g_ascii_strcasecmp (value, "no") ||
-	     0 == g_strcmp0 (value, "0")) {
-    bvalue = FALSE;
+  if (0 == g_ascii_strcasecmp (svalue, "true") ||
+      0 == g_ascii_strcasecmp (svalue, "yes") ||
+      0 == g_strcmp0 (svalue, "1")) {
+    g_value_set_boolean (value, TRUE);
+  } else if (0 == g_ascii_strcasecmp (svalue, "false") ||
+	     0 == g_ascii_strcasecmp (svalue, "no") ||
+	     0 == g_strcmp0 (svalue, "0")) {
+    g_value_set_boolean (value, FALSE);
   } else {
     return GSTD_BAD_VALUE;
   }
 
-  g_object_set (prop->target, GSTD_OBJECT_NAME(prop), bvalue, NULL);
-  return ret;
+  return GSTD_EOK;
 }
@@ -21,6 +21,8 @@
 #include "config.h"
 #endif
 
+#include <errno.h>
+
 #include "gstd_property_enum.h"
 
 /* Gstd Property debugging category */
@@ -33,16 +35,21 @@ GST_DEBUG_CATEGORY_STATIC(gstd_property_enum_debug);
 G_DEFINE_TYPE (GstdPropertyEnum, gstd_property_enum, GSTD_TYPE_PROPERTY)
 
 /* VTable */
+static void
+gstd_property_enum_add_value (GstdProperty * self, GstdIFormatter *formatter,
+    GValue * value);
 static GstdReturnCode
-gstd_property_enum_update (GstdObject * object, const gchar * arg);
+gstd_property_enum_parse (GParamSpec * pspec, const gchar * svalue,
+    GValue * value);
 
 static void
 gstd_property_enum_class_init (GstdPropertyEnumClass *klass)
 {
   guint debug_color;
-  GstdObjectClass *oclass = GSTD_OBJECT_CLASS (klass);
+  GstdPropertyClass *pclass = GSTD_PROPERTY_CLASS (klass);
 
-  oclass->update = GST_DEBUG_FUNCPTR(gstd_property_enum_update);
+  pclass->parse = GST_DEBUG_FUNCPTR(gstd_property_enum_parse);
+  pclass->add_value = GST_DEBUG_FUNCPTR(gstd_property_enum_add_value);
 
   /* Initialize debug category with nice colors */
   debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
@@ -57,57 +64,70 @@ gstd_property_enum_init (GstdPropertyEnum *self)
   GST_INFO_OBJECT(self, "Initializing property enum");
 }
 
-static GstdReturnCode
-gstd_property_enum_update (GstdObject * object, const gchar * value)
+/* Writes the name of the value, as gst_value_serialize() does, or the
+ * number itself if the enum doesn't know it */
+static void
+gstd_property_enum_add_value (GstdProperty * self, GstdIFormatter *formatter,
+    GValue * value)
 {
-  GstdReturnCode ret = GSTD_EOK;
-  GstdPropertyEnum * self;
-  GstdProperty * prop;
-  GParamSpec *pspec;
-  GEnumClass *c;
   GEnumValue *e;
-  guint64 d;
+  GValue number_value = G_VALUE_INIT;
+  gchar number[16];
 
-  g_return_val_if_fail (object, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (value, GSTD_NULL_ARGUMENT);
+  /* The param spec holds a reference on the class */
+  e = g_enum_get_value (g_type_class_peek (G_VALUE_TYPE (value)),
+      g_value_get_enum (value));
+  if (e) {
+    gstd_iformatter_set_string_value (formatter, e->value_name);
+    return;
+  }
 
-  self = GSTD_PROPERTY_ENUM (object);
-  prop = GSTD_PROPERTY (object);
+  /* Values the type doesn't define are written as their number, a
+   * native one in binary formats */
+  if (gstd_object_get_binary ()) {
+    g_value_init (&number_value, G_TYPE_INT);
+    g_value_set_int (&number_value, g_value_get_enum (value));
+    gstd_iformatter_set_value (formatter, &number_value);
+    g_value_unset (&number_value);
+    return;
+  }
 
-  g_return_val_if_fail (self->type != G_TYPE_NONE, GSTD_MISSING_INITIALIZATION);
+  g_snprintf (number, sizeof (number), "%d", g_value_get_enum (value));
+  gstd_iformatter_set_string_value (formatter, number);
+}
 
-  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS(prop->target),
-      GSTD_OBJECT_NAME(prop));
+static GstdReturnCode
+gstd_property_enum_parse (GParamSpec * pspec, const gchar * svalue,
+    GValue * value)
+{
+  GEnumClass *c;
+  GEnumValue *e;
+  gchar *end;
+  gint64 d;
 
-  c = g_type_class_ref (pspec->value_type);
+  c = G_PARAM_SPEC_ENUM (pspec)->enum_class;
 
-  /* Try by name */
-  e = g_enum_get_value_by_name (c, value);
-  if (e) {
-    goto out;
+  /* Try by name, then by nick */
+  e = g_enum_get_value_by_name (c, svalue);
+  if (!e) {
+    e = g_enum_get_value_by_nick (c, svalue);
   }
 
-  /* Try by nick */
-  e = g_enum_get_value_by_nick (c, value);
-  if (e) {
-    goto out;
+  /* Try by integer, which must still be one of the values */
+  if (!e) {
+    errno = 0;
+    d = g_ascii_strtoll (svalue, &end, 10);
+    if (!errno && end != svalue && '\0' == *end && d >= G_MININT
+        && d <= G_MAXINT) {
+      e = g_enum_get_value (c, d);
+    }
   }
 
-  /* Try by integer */
-  errno = 0;
-  d = g_ascii_strtoll (value, NULL, 10);
-  if (d || !errno) {
-    g_object_set (prop->target, pspec->name, d, NULL);
-    goto error; //Not an error
+  if (!e) {
+    return GSTD_BAD_VALUE;
   }
 
-  ret = GSTD_BAD_VALUE;
-  goto error;
-
- out:
-  g_object_set (prop->target, pspec->name, e->value, NULL);
+  g_value_set_enum (value, e->value);
 
- error:
-  g_type_class_unref (c);
-  return ret;
+  return GSTD_EOK;
 }
@@ -50,8 +50,6 @@ GType gstd_property_enum_get_type();
 struct _GstdPropertyEnum
 {
   GstdProperty parent;
-
-  GType type;
 };
 
 struct _GstdPropertyEnumClass
@@ -21,8 +21,10 @@
 #include "config.h"
 #endif
 
+#include <errno.h>
+#include <string.h>
+
 #include "gstd_property_flags.h"
-#include "gstd_msg_type.h"
 
 /* Gstd Property debugging category */
 GST_DEBUG_CATEGORY_STATIC(gstd_property_flags_debug);
@@ -31,19 +33,27 @@ GST_DEBUG_CATEGORY_STATIC(gstd_property_flags_debug);
 #define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
 
 
+/* Longest flag name or nick accepted by parse */
+#define GSTD_PROPERTY_FLAGS_MAX_NAME 128
+
 G_DEFINE_TYPE (GstdPropertyFlags, gstd_property_flags, GSTD_TYPE_PROPERTY)
 
 /* VTable */
+static void
+gstd_property_flags_add_value (GstdProperty * self, GstdIFormatter *formatter,
+    GValue * value);
 static GstdReturnCode
-gstd_property_flags_update (GstdObject * object, const gchar * arg);
+gstd_property_flags_parse (GParamSpec * pspec, const gchar * svalue,
+    GValue * value);
 
 static void
 gstd_property_flags_class_init (GstdPropertyFlagsClass *klass)
 {
   guint debug_color;
-  GstdObjectClass *oclass = GSTD_OBJECT_CLASS (klass);
+  GstdPropertyClass *pclass = GSTD_PROPERTY_CLASS (klass);
 
-  oclass->update = GST_DEBUG_FUNCPTR(gstd_property_flags_update);
+  pclass->parse = GST_DEBUG_FUNCPTR(gstd_property_flags_parse);
+  pclass->add_value = GST_DEBUG_FUNCPTR(gstd_property_flags_add_value);
 
   /* Initialize debug category with nice colors */
   debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
@@ -58,34 +68,108 @@ gstd_property_flags_init (GstdPropertyFlags *self)
   GST_INFO_OBJECT(self, "Initializing property flags");
 }
 
-static GstdReturnCode
-gstd_property_flags_update (GstdObject * object, const gchar * svalue)
+/* Writes the names of the flags joined by '+', as gst_value_serialize()
+ * does. Bits the flags type doesn't know are appended as a number */
+static void
+gstd_property_flags_add_value (GstdProperty * self, GstdIFormatter *formatter,
+    GValue * value)
 {
-  GstdReturnCode ret = GSTD_EOK;
-  GstdPropertyFlags * self;
-  GstdProperty * prop;
-  GParamSpec *pspec;
-  GValue value = G_VALUE_INIT;
+  GFlagsClass *c;
+  GFlagsValue *f;
+  GString *names;
+  guint flags;
+
+  /* The param spec holds a reference on the class */
+  c = g_type_class_peek (G_VALUE_TYPE (value));
+  flags = g_value_get_flags (value);
 
-  g_return_val_if_fail (object, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (svalue, GSTD_NULL_ARGUMENT);
+  names = g_string_sized_new (64);
+
+  f = g_flags_get_first_value (c, flags);
+  if (0 == flags && f) {
+    g_string_append (names, f->value_name);
+  }
 
-  self = GSTD_PROPERTY_FLAGS (object);
-  prop = GSTD_PROPERTY (object);
+  while (flags) {
+    f = g_flags_get_first_value (c, flags);
+    if (!f || 0 == f->value) {
+      g_string_append_printf (names, "%s0x%08x", names->len ? "+" : "",
+          flags);
+      break;
+    }
+
+    if (names->len) {
+      g_string_append_c (names, '+');
+    }
+    g_string_append (names, f->value_name);
+    flags &= ~f->value;
+  }
 
-  g_return_val_if_fail (self->type != G_TYPE_NONE, GSTD_MISSING_INITIALIZATION);
+  if (0 == names->len) {
+    g_string_append_c (names, '0');
+  }
 
-  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS(prop->target),
-      GSTD_OBJECT_NAME(prop));
+  gstd_iformatter_set_string_value (formatter, names->str);
+  g_string_free (names, TRUE);
+}
 
-  g_value_init(&value, pspec->value_type);
+/* Flags are given as their names, nicks or numbers joined by '+' or '|',
+ * like gst_value_deserialize() takes them */
+static GstdReturnCode
+gstd_property_flags_parse (GParamSpec * pspec, const gchar * svalue,
+    GValue * value)
+{
+  GFlagsClass *c;
+  GFlagsValue *f;
+  gchar name[GSTD_PROPERTY_FLAGS_MAX_NAME];
+  const gchar *token;
+  gchar *end;
+  gsize length;
+  guint64 number;
+  guint flags = 0;
+
+  c = G_PARAM_SPEC_FLAGS (pspec)->flags_class;
+
+  for (token = svalue; ; token += length + 1) {
+    length = strcspn (token, "+|");
+    if (0 == length || length >= sizeof (name)) {
+      goto bad_value;
+    }
+
+    memcpy (name, token, length);
+    name[length] = '\0';
+
+    f = g_flags_get_value_by_name (c, name);
+    if (!f) {
+      f = g_flags_get_value_by_nick (c, name);
+    }
+
+    if (f) {
+      flags |= f->value;
+    } else {
+      errno = 0;
+      number = g_ascii_strtoull (name, &end, 0);
+      if (errno || end == name || '\0' != *end || '-' == name[0]
+          || number > G_MAXUINT) {
+        goto bad_value;
+      }
+      flags |= number;
+    }
+
+    if ('\0' == token[length]) {
+      break;
+    }
+  }
 
-  if (!gst_value_deserialize (&value, svalue)) {
-    ret = GSTD_BAD_VALUE;
-  } else {
-    g_object_set_property (prop->target, pspec->name, &value);
-    ret = GSTD_EOK;
+  /* Only bits the flags type knows about */
+  if (flags & ~c->mask) {
+    goto bad_value;
   }
 
-  return ret;
+  g_value_set_flags (value, flags);
+
+  return GSTD_EOK;
+
+bad_value:
+  return GSTD_BAD_VALUE;
 }
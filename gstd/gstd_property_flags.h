@@ -50,8 +50,6 @@ GType gstd_property_flags_get_type();
 struct _GstdPropertyFlags
 {
   GstdProperty parent;
-
-  GType type;
 };
 
 struct _GstdPropertyFlagsClass
@@ -21,6 +21,9 @@
 #include "config.h"
 #endif
 
+#include <errno.h>
+#include <string.h>
+
 #include "gstd_property_int.h"
 
 /* Gstd Property debugging category */
@@ -37,16 +40,16 @@ static void
 gstd_property_int_add_value (GstdProperty * self, GstdIFormatter *formatter,
     GValue * value);
 static GstdReturnCode
-gstd_property_int_update (GstdObject * object, const gchar * arg);
+gstd_property_int_parse_value (GParamSpec * pspec, const gchar * svalue,
+    GValue * value);
 
 static void
 gstd_property_int_class_init (GstdPropertyIntClass *klass)
 {
   guint debug_color;
   GstdPropertyClass *pclass = GSTD_PROPERTY_CLASS (klass);
-  GstdObjectClass *oclass = GSTD_OBJECT_CLASS (klass);
 
-  oclass->update = GST_DEBUG_FUNCPTR(gstd_property_int_update);
+  pclass->parse = GST_DEBUG_FUNCPTR(gstd_property_int_parse_value);
   pclass->add_value = GST_DEBUG_FUNCPTR(gstd_property_int_add_value);
 
   /* Initialize debug category with nice colors */
@@ -62,68 +65,139 @@ gstd_property_int_init (GstdPropertyInt *self)
   GST_INFO_OBJECT(self, "Initializing property int");
 }
 
+/* Text formats get the decimal strings gst_value_serialize() always
+ * produced, clients parse them from there. Binary formats carry the
+ * number itself */
 static void
 gstd_property_int_add_value (GstdProperty * self, GstdIFormatter *formatter,
     GValue * value)
 {
-  gstd_iformatter_set_value (formatter, value);
+  gchar number[32];
+
+  if (gstd_object_get_binary ()) {
+    gstd_iformatter_set_value (formatter, value);
+    return;
+  }
+
+  switch (G_VALUE_TYPE (value)) {
+    case G_TYPE_INT:
+      g_snprintf (number, sizeof (number), "%d", g_value_get_int (value));
+      break;
+    case G_TYPE_UINT:
+      g_snprintf (number, sizeof (number), "%u", g_value_get_uint (value));
+      break;
+    case G_TYPE_INT64:
+      g_snprintf (number, sizeof (number), "%" G_GINT64_FORMAT,
+          g_value_get_int64 (value));
+      break;
+    case G_TYPE_UINT64:
+      g_snprintf (number, sizeof (number), "%" G_GUINT64_FORMAT,
+          g_value_get_uint64 (value));
+      break;
+    default:
+      g_return_if_reached ();
+  }
+
+  gstd_iformatter_set_string_value (formatter, number);
 }
 
-static GstdReturnCode
-gstd_property_int_update (GstdObject * object, const gchar * value)
+/* Parses the whole of value as a number, without the detours through
+ * gst_value_deserialize() but accepting what it did: decimal, octal or
+ * hexadecimal numbers and the "min" and "max" of the type, given as min
+ * and max */
+static gboolean
+gstd_property_int_parse (const gchar * value, gboolean is_signed,
+    gint64 min, guint64 max, gint64 * parsed, guint64 * uparsed)
 {
-  GstdProperty *prop;
-  GParamSpec *pspec;
-  GstdReturnCode ret = GSTD_EOK;
-  gint64 parsed;
+  gchar *end;
 
-  g_return_val_if_fail (object, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (value, GSTD_NULL_ARGUMENT);
+  if (!g_ascii_strcasecmp (value, "min")) {
+    if (is_signed) {
+      *parsed = min;
+    } else {
+      *uparsed = min;
+    }
+    return TRUE;
+  }
 
-  prop = GSTD_PROPERTY (object);
+  if (!g_ascii_strcasecmp (value, "max")) {
+    if (is_signed) {
+      *parsed = max;
+    } else {
+      *uparsed = max;
+    }
+    return TRUE;
+  }
 
-  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS(prop->target),
-      GSTD_OBJECT_NAME(prop));
+  errno = 0;
 
-  g_return_val_if_fail (pspec, GSTD_MISSING_INITIALIZATION);
+  if (is_signed) {
+    *parsed = g_ascii_strtoll (value, &end, 0);
+  } else {
+    /* strtoull() happily wraps negative numbers around */
+    if (strchr (value, '-')) {
+      return FALSE;
+    }
+    *uparsed = g_ascii_strtoull (value, &end, 0);
+  }
 
-  errno = 0;
+  return !errno && end != value && '\0' == *end;
+}
+
+/* Values are checked against the range of the property */
+static GstdReturnCode
+gstd_property_int_parse_value (GParamSpec * pspec, const gchar * svalue,
+    GValue * value)
+{
+  gint64 parsed = 0;
+  guint64 uparsed = 0;
+  gboolean valid;
 
   switch (pspec->value_type) {
-  case G_TYPE_INT64:
   case G_TYPE_INT:
     {
-      parsed = g_ascii_strtoll (value, NULL, 10);
-      if (!parsed && errno) {
-	GST_ERROR_OBJECT (object, "Cannot update %s: %s", pspec->name,
-            g_strerror(errno));
-	ret = GSTD_BAD_VALUE;
-	goto out;
-      }
+      GParamSpecInt *range = G_PARAM_SPEC_INT (pspec);
+
+      valid = gstd_property_int_parse (svalue, TRUE, G_MININT, G_MAXINT,
+          &parsed, NULL) && parsed >= range->minimum
+          && parsed <= range->maximum;
+      g_value_set_int (value, parsed);
       break;
     }
-  case G_TYPE_UINT64:
   case G_TYPE_UINT:
     {
-      parsed = g_ascii_strtoull (value, NULL, 10);
-      if (!parsed && errno) {
-	GST_ERROR_OBJECT (object, "Cannot update %s: %s", pspec->name,
-            g_strerror(errno));
-	ret = GSTD_BAD_VALUE;
-	goto out;
-      }
+      GParamSpecUInt *range = G_PARAM_SPEC_UINT (pspec);
+
+      valid = gstd_property_int_parse (svalue, FALSE, 0, G_MAXUINT, NULL,
+          &uparsed) && uparsed >= range->minimum
+          && uparsed <= range->maximum;
+      g_value_set_uint (value, uparsed);
       break;
     }
-  default:
-    g_warn_if_reached ();
-    goto out;
-  }
+  case G_TYPE_INT64:
+    {
+      GParamSpecInt64 *range = G_PARAM_SPEC_INT64 (pspec);
 
-  g_object_set (prop->target, GSTD_OBJECT_NAME(prop), parsed, NULL);
+      valid = gstd_property_int_parse (svalue, TRUE, G_MININT64, G_MAXINT64,
+          &parsed, NULL) && parsed >= range->minimum
+          && parsed <= range->maximum;
+      g_value_set_int64 (value, parsed);
+      break;
+    }
+  case G_TYPE_UINT64:
+    {
+      GParamSpecUInt64 *range = G_PARAM_SPEC_UINT64 (pspec);
 
- out:
-  {
-    return ret;
+      valid = gstd_property_int_parse (svalue, FALSE, 0, G_MAXUINT64, NULL,
+          &uparsed) && uparsed >= range->minimum
+          && uparsed <= range->maximum;
+      g_value_set_uint64 (value, uparsed);
+      break;
+    }
+  default:
+    g_warn_if_reached ();
+    valid = FALSE;
   }
 
+  return valid ? GSTD_EOK : GSTD_BAD_VALUE;
 }
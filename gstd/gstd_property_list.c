@@ -0,0 +1,293 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+
+#include "gstd_property_list.h"
+#include "gstd_property.h"
+#include "gstd_schema.h"
+
+enum
+{
+  PROP_TARGET = 1,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+/* Gstd Property List debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_property_list_debug);
+#define GST_CAT_DEFAULT gstd_property_list_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/* Property nodes kept per list, elements seldom have more properties
+ * being driven at once */
+#define GSTD_PROPERTY_LIST_MAX_NODES 32
+
+struct _GstdPropertyList
+{
+  GstdList parent;
+
+  /*
+   * The object whose properties are listed
+   */
+  GObject *target;
+
+  /*
+   * Shared with every object of the same type
+   */
+  const GstdSchema *schema;
+
+  /*
+   * Concurrent reads may create the same node
+   */
+  GMutex lock;
+};
+
+struct _GstdPropertyListClass
+{
+  GstdListClass parent_class;
+};
+
+G_DEFINE_TYPE (GstdPropertyList, gstd_property_list, GSTD_TYPE_LIST);
+
+/* VTable */
+static void gstd_property_list_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void gstd_property_list_get_property (GObject *, guint, GValue *,
+    GParamSpec *);
+static void gstd_property_list_dispose (GObject *);
+static void gstd_property_list_finalize (GObject *);
+static GstdObject *gstd_property_list_find_child (GstdList * list,
+    const gchar * name);
+static void gstd_property_list_foreach_name (GstdList * list,
+    GstdListNameFunc func, gpointer user_data);
+
+static void
+gstd_property_list_class_init (GstdPropertyListClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GstdListClass *list_class = GSTD_LIST_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+
+  object_class->set_property = gstd_property_list_set_property;
+  object_class->get_property = gstd_property_list_get_property;
+  object_class->dispose = gstd_property_list_dispose;
+  object_class->finalize = gstd_property_list_finalize;
+
+  properties[PROP_TARGET] =
+      g_param_spec_object ("target",
+      "Target",
+      "The object whose properties are listed",
+      G_TYPE_OBJECT,
+      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  list_class->find_child = gstd_property_list_find_child;
+  list_class->foreach_name = gstd_property_list_foreach_name;
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_property_list_debug, "gstdpropertylist",
+      debug_color, "Gstd Property List category");
+}
+
+static void
+gstd_property_list_init (GstdPropertyList * self)
+{
+  GST_INFO_OBJECT (self, "Initializing property list");
+  self->target = NULL;
+  self->schema = NULL;
+  g_mutex_init (&self->lock);
+}
+
+static void
+gstd_property_list_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdPropertyList *self = GSTD_PROPERTY_LIST (object);
+
+  switch (property_id) {
+    case PROP_TARGET:
+      self->target = g_value_dup_object (value);
+      if (!self->target) {
+        break;
+      }
+      self->schema = gstd_schema_get (G_OBJECT_TYPE (self->target));
+      GSTD_LIST (self)->count = self->schema->n_properties;
+      GST_DEBUG_OBJECT (self, "Listing %u properties",
+          self->schema->n_properties);
+      break;
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_property_list_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdPropertyList *self = GSTD_PROPERTY_LIST (object);
+
+  switch (property_id) {
+    case PROP_TARGET:
+      g_value_set_object (value, self->target);
+      break;
+    default:
+      /* Let the list handle its own properties */
+      G_OBJECT_CLASS (gstd_property_list_parent_class)->get_property (object,
+          property_id, value, pspec);
+      break;
+  }
+}
+
+static void
+gstd_property_list_dispose (GObject * object)
+{
+  GstdPropertyList *self = GSTD_PROPERTY_LIST (object);
+
+  GST_INFO_OBJECT (self, "Disposing %s property list",
+      GSTD_OBJECT_NAME (self));
+
+  g_clear_object (&self->target);
+
+  G_OBJECT_CLASS (gstd_property_list_parent_class)->dispose (object);
+}
+
+static void
+gstd_property_list_finalize (GObject * object)
+{
+  GstdPropertyList *self = GSTD_PROPERTY_LIST (object);
+
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (gstd_property_list_parent_class)->finalize (object);
+}
+
+/* Drops the least recently used node. Whoever still holds a reference
+ * to it keeps a working node, later lookups create a fresh one */
+static void
+gstd_property_list_evict (GstdPropertyList * self)
+{
+  GstdList *list = GSTD_LIST (self);
+  GList *link;
+  GstdObject *node;
+
+  link = g_queue_pop_head_link (list->list);
+  node = GSTD_OBJECT (link->data);
+  g_list_free_1 (link);
+
+  GST_DEBUG_OBJECT (self, "Evicting node for property %s",
+      GSTD_OBJECT_NAME (node));
+
+  g_hash_table_remove (list->index, GSTD_OBJECT_NAME (node));
+
+  /* Paths resolved to the node no longer lead to the list's node */
+  g_atomic_int_inc (&list->generation);
+
+  g_object_unref (node);
+}
+
+/* Nodes are created the first time they are accessed, so only the
+ * properties clients actually use cost a GstdProperty. At most
+ * GSTD_PROPERTY_LIST_MAX_NODES of them are kept, the queue of the list
+ * is ordered by last access and the least recently used node goes
+ * first. */
+static GstdObject *
+gstd_property_list_find_child (GstdList * list, const gchar * name)
+{
+  GstdPropertyList *self = GSTD_PROPERTY_LIST (list);
+  GstdObject *child = NULL;
+  const GstdSchemaProperty *property;
+  GParamSpec *pspec;
+  GList *link;
+  GType type;
+
+  g_mutex_lock (&self->lock);
+
+  if (!self->target) {
+    goto out;
+  }
+
+  /* Nodes are named after the canonical name, a lookup spelled
+   * differently (num_buffers) finds the same node */
+  property = gstd_schema_find (self->schema, name);
+  if (!property) {
+    goto out;
+  }
+  pspec = property->pspec;
+
+  link = g_hash_table_lookup (list->index, pspec->name);
+  if (link) {
+    g_queue_unlink (list->list, link);
+    g_queue_push_tail_link (list->list, link);
+    child = g_object_ref (link->data);
+    goto out;
+  }
+
+  if (g_queue_get_length (list->list) >= GSTD_PROPERTY_LIST_MAX_NODES) {
+    gstd_property_list_evict (self);
+  }
+
+  GST_DEBUG_OBJECT (self, "Creating node for property %s", pspec->name);
+
+  type = gstd_property_node_type (pspec);
+  child = g_object_new (type, "name", pspec->name, "target", self->target,
+      NULL);
+  GSTD_PROPERTY (child)->owned = TRUE;
+  if (!gstd_list_append_child (list, child)) {
+    g_object_unref (child);
+    child = NULL;
+    goto out;
+  }
+  g_object_ref (child);
+
+  /* The count covers every property, not only the created ones */
+  list->count = self->schema->n_properties;
+
+out:
+  g_mutex_unlock (&self->lock);
+
+  return child;
+}
+
+static void
+gstd_property_list_foreach_name (GstdList * list, GstdListNameFunc func,
+    gpointer user_data)
+{
+  GstdPropertyList *self = GSTD_PROPERTY_LIST (list);
+  guint i;
+
+  if (!self->schema) {
+    return;
+  }
+
+  for (i = 0; i < self->schema->n_properties; i++) {
+    if (!func (self->schema->properties[i].pspec->name, user_data)) {
+      break;
+    }
+  }
+}
@@ -21,11 +21,7 @@
 
 #include "gstd_property_reader.h"
 #include "gstd_object.h"
-#include "gstd_property_int.h"
-#include "gstd_property_string.h"
-#include "gstd_property_boolean.h"
-#include "gstd_property_enum.h"
-#include "gstd_property_flags.h"
+#include "gstd_property.h"
 
 /* Gstd Core debugging category */
 GST_DEBUG_CATEGORY_STATIC (gstd_property_reader_debug);
@@ -115,45 +111,7 @@ gstd_property_mask_type (GstdObject * object, const gchar * name, GstdObject **
     klass = G_OBJECT_GET_CLASS(object);
     pspec = g_object_class_find_property (klass, name);
 
-    switch (pspec->value_type) {
-      case G_TYPE_BOOLEAN:
-      {
-	type = GSTD_TYPE_PROPERTY_BOOLEAN;
-	break;
-      }	
-      case G_TYPE_INT:
-      case G_TYPE_UINT:
-      case G_TYPE_UINT64:
-      case G_TYPE_INT64:
-      {
-	type = GSTD_TYPE_PROPERTY_INT;
-	break;
-      }	  
-      case G_TYPE_STRING:
-      {
-	type = GSTD_TYPE_PROPERTY_STRING;
-	break;	
-      }
-      default:
-      {
-	if (G_TYPE_IS_ENUM(pspec->value_type)) {
-	  type = GSTD_TYPE_PROPERTY_ENUM;
-	} else if (G_TYPE_IS_FLAGS(pspec->value_type)) {
-	  type = GSTD_TYPE_PROPERTY_FLAGS;
-	} else {
-	  type = GSTD_TYPE_PROPERTY;
-	}
-      }
-    }
-
-    //FIXME:
-    //I just found a way to handle all types in a generic way, hence,
-    //the base property class can handle them all. I don't want to remove
-    //specific type sublasses because the to_string method may require to
-    //add details. For example, int properties can display their max and min
-    //values, flags and enums could display the options, etc... Similar to
-    //what gst-inspect does
-    type = GSTD_TYPE_PROPERTY;
+    type = gstd_property_node_type (pspec);
 
     *out = GSTD_OBJECT(g_object_new(type, "name", pspec->name, "target", object, NULL));
 
@@ -37,16 +37,16 @@ static void
 gstd_property_string_add_value (GstdProperty * self, GstdIFormatter *formatter,
     GValue * value);
 static GstdReturnCode
-gstd_property_string_update (GstdObject * object, const gchar * arg);
+gstd_property_string_parse (GParamSpec * pspec, const gchar * svalue,
+    GValue * value);
 
 static void
 gstd_property_string_class_init (GstdPropertyStringClass *klass)
 {
   guint debug_color;
   GstdPropertyClass *pclass = GSTD_PROPERTY_CLASS (klass);
-  GstdObjectClass *oclass = GSTD_OBJECT_CLASS (klass);
 
-  oclass->update = GST_DEBUG_FUNCPTR(gstd_property_string_update);
+  pclass->parse = GST_DEBUG_FUNCPTR(gstd_property_string_parse);
   pclass->add_value = GST_DEBUG_FUNCPTR(gstd_property_string_add_value);
 
   /* Initialize debug category with nice colors */
@@ -66,20 +66,23 @@ static void
 gstd_property_string_add_value (GstdProperty * self, GstdIFormatter *formatter,
     GValue * value)
 {
-  gstd_iformatter_set_value (formatter, value);
+  const gchar *str = g_value_get_string (value);
+
+  /* Unset strings read as gst_value_serialize() always wrote them */
+  gstd_iformatter_set_string_value (formatter, str ? str : "NULL");
 }
 
 static GstdReturnCode
-gstd_property_string_update (GstdObject * object, const gchar * value)
+gstd_property_string_parse (GParamSpec * pspec, const gchar * svalue,
+    GValue * value)
 {
-  GstdProperty * prop;
-
-  g_return_val_if_fail (object, GSTD_NULL_ARGUMENT);
-  g_return_val_if_fail (value, GSTD_NULL_ARGUMENT);
-
-  prop = GSTD_PROPERTY (object);
+  /* Quoted strings may carry escapes, leave them to the generic path */
+  if ('"' == svalue[0]) {
+    return GSTD_PROPERTY_CLASS (gstd_property_string_parent_class)->parse
+        (pspec, svalue, value);
+  }
 
-  g_object_set (prop->target, GSTD_OBJECT_NAME(prop), value, NULL);
+  g_value_set_string (value, svalue);
 
   return GSTD_EOK;
 }
@@ -0,0 +1,128 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+
+#include "gstd_schema.h"
+#include "gstd_object.h"
+
+/* Gstd Schema debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_schema_debug);
+#define GST_CAT_DEFAULT gstd_schema_debug
+
+/* Schemas are never freed, types are not unloaded while gstd runs */
+static GHashTable *schemas = NULL;
+G_LOCK_DEFINE_STATIC (schemas);
+
+static GstdSchema *
+gstd_schema_new (GType type)
+{
+  GstdSchema *schema;
+  GstdSchemaProperty *property;
+  GObjectClass *klass;
+  GParamSpec **pspecs;
+  GValue flags = G_VALUE_INIT;
+  guint i;
+
+  /* The param specs belong to the class, keep it around */
+  klass = g_type_class_ref (type);
+  pspecs = g_object_class_list_properties (klass, &i);
+
+  schema = g_new0 (GstdSchema, 1);
+  schema->type = type;
+  schema->n_properties = i;
+  schema->properties = g_new0 (GstdSchemaProperty, schema->n_properties);
+  schema->index = g_hash_table_new (g_str_hash, g_str_equal);
+
+  g_value_init (&flags, GSTD_TYPE_PARAM_FLAGS);
+
+  for (i = 0; i < schema->n_properties; i++) {
+    property = &schema->properties[i];
+
+    property->pspec = pspecs[i];
+    property->blurb = g_param_spec_get_blurb (pspecs[i]);
+    property->type_name = g_type_name (pspecs[i]->value_type);
+    property->construct = GSTD_PARAM_IS_DELETE (pspecs[i]->flags);
+
+    g_value_set_flags (&flags, pspecs[i]->flags);
+    property->access = g_strdup_value_contents (&flags);
+
+    g_hash_table_insert (schema->index, (gpointer) pspecs[i]->name, property);
+  }
+
+  g_value_unset (&flags);
+  g_free (pspecs);
+
+  GST_DEBUG ("Built the schema of %s, %u properties", g_type_name (type),
+      schema->n_properties);
+
+  return schema;
+}
+
+const GstdSchema *
+gstd_schema_get (GType type)
+{
+  GstdSchema *schema;
+
+  g_return_val_if_fail (G_TYPE_IS_OBJECT (type), NULL);
+
+  G_LOCK (schemas);
+
+  if (!schemas) {
+    GST_DEBUG_CATEGORY_INIT (gstd_schema_debug, "gstdschema",
+        GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE,
+        "Gstd Schema category");
+    schemas = g_hash_table_new (g_direct_hash, g_direct_equal);
+  }
+
+  schema = g_hash_table_lookup (schemas, GSIZE_TO_POINTER (type));
+  if (!schema) {
+    schema = gstd_schema_new (type);
+    g_hash_table_insert (schemas, GSIZE_TO_POINTER (type), schema);
+  }
+
+  G_UNLOCK (schemas);
+
+  return schema;
+}
+
+const GstdSchemaProperty *
+gstd_schema_find (const GstdSchema * schema, const gchar * name)
+{
+  const GstdSchemaProperty *property;
+  GParamSpec *pspec;
+
+  g_return_val_if_fail (schema, NULL);
+  g_return_val_if_fail (name, NULL);
+
+  property = g_hash_table_lookup (schema->index, name);
+  if (property) {
+    return property;
+  }
+
+  /* Let GObject resolve non canonical names, such as "num_buffers" */
+  pspec = g_object_class_find_property (g_type_class_peek (schema->type),
+      name);
+
+  return pspec ? g_hash_table_lookup (schema->index, pspec->name) : NULL;
+}
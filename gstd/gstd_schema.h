@@ -0,0 +1,78 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_SCHEMA_H__
+#define __GSTD_SCHEMA_H__
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GstdSchemaProperty GstdSchemaProperty;
+typedef struct _GstdSchema GstdSchema;
+
+/**
+ * GstdSchemaProperty:
+ * The static description of a property, as written in its "param_spec"
+ * member.
+ */
+struct _GstdSchemaProperty
+{
+  GParamSpec *pspec;
+  const gchar *blurb;
+  const gchar *type_name;
+  gchar *access;
+  gboolean construct;
+};
+
+/**
+ * GstdSchema:
+ * The properties of a type, in the order g_object_class_list_properties()
+ * gives them. Built the first time the type is serialized and kept for
+ * the lifetime of the process, so serializers only fetch live values.
+ */
+struct _GstdSchema
+{
+  GType type;
+  guint n_properties;
+  GstdSchemaProperty *properties;
+  GHashTable *index;
+};
+
+/**
+ * gstd_schema_get:
+ * @type: A #GObject type
+ *
+ * Returns: (transfer none): The schema of @type, shared by every caller
+ */
+const GstdSchema *gstd_schema_get (GType type);
+
+/**
+ * gstd_schema_find:
+ * @schema: The schema to search
+ * @name: The name of a property
+ *
+ * Returns: (transfer none) (nullable): The description of @name, or NULL
+ * if @schema has no such property
+ */
+const GstdSchemaProperty *gstd_schema_find (const GstdSchema * schema,
+    const gchar * name);
+
+G_END_DECLS
+#endif // __GSTD_SCHEMA_H__
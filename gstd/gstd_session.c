@@ -21,6 +21,8 @@
 #include "config.h"
 #endif
 
+#include <string.h>
+
 #include "gstd_session.h"
 #include "gstd_list.h"
 #include "gstd_tcp.h"
@@ -42,12 +44,38 @@ enum
   PROP_PIPELINES = 1,
   PROP_PID,
   PROP_DEBUG,
+  PROP_URI_CACHE_HITS,
+  PROP_URI_CACHE_MISSES,
   N_PROPERTIES                  // NOT A PROPERTY
 };
 
 #define GSTD_SESSION_DEFAULT_PIPELINES NULL
 #define GSTD_DEFAULT_PID -1
 
+/* Maximum number of cached URIs, so URIs that are never requested again
+ * don't pile up */
+#define GSTD_SESSION_URI_CACHE_SIZE 4096
+
+/* A list walked through to reach a cached node, along with its
+ * generation at the time */
+typedef struct _GstdSessionCacheList
+{
+  GWeakRef list;
+  guint generation;
+} GstdSessionCacheList;
+
+/* A resolved node. The tree owns the node, the entry only holds a weak
+ * reference and is stale once any list along its path changes */
+typedef struct _GstdSessionCacheEntry
+{
+  gchar *key;
+  GWeakRef node;
+  GstdSessionCacheList *lists;
+  guint n_lists;
+  /* Set by every hit, spares the entry one pass of the eviction clock */
+  gint referenced;
+} GstdSessionCacheEntry;
+
 G_DEFINE_TYPE (GstdSession, gstd_session, GSTD_TYPE_OBJECT);
 
 /* VTable */
@@ -56,8 +84,15 @@ gstd_session_set_property (GObject *, guint, const GValue *, GParamSpec *);
 static void gstd_session_get_property (GObject *, guint, GValue *,
     GParamSpec *);
 static void gstd_session_dispose (GObject *);
+static void gstd_session_finalize (GObject *);
 static GObject *gstd_session_constructor (GType, guint,
     GObjectConstructParam *);
+static void gstd_session_cache_entry_free (gpointer data);
+static void gstd_session_cache_entry_set (GstdSessionCacheEntry * entry,
+    GstdObject * node, GPtrArray * lists, GArray * generations);
+static void gstd_session_cache_entry_clear (GstdSessionCacheEntry * entry);
+static gboolean gstd_session_cache_entry_is_valid (GstdSessionCacheEntry *
+    entry);
 
 
 static GObject *
@@ -93,6 +128,7 @@ gstd_session_class_init (GstdSessionClass * klass)
   object_class->set_property = gstd_session_set_property;
   object_class->get_property = gstd_session_get_property;
   object_class->dispose = gstd_session_dispose;
+  object_class->finalize = gstd_session_finalize;
   object_class->constructor = gstd_session_constructor;
 
   properties[PROP_PIPELINES] =
@@ -117,6 +153,20 @@ gstd_session_class_init (GstdSessionClass * klass)
       "The debug object containing debug information",
       GSTD_TYPE_DEBUG, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+  properties[PROP_URI_CACHE_HITS] =
+      g_param_spec_uint ("uri-cache-hits",
+      "URI Cache Hits",
+      "The URIs resolved from the cache",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_URI_CACHE_MISSES] =
+      g_param_spec_uint ("uri-cache-misses",
+      "URI Cache Misses",
+      "The URIs resolved by walking the tree",
+      0, G_MAXUINT, 0,
+      G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
   g_object_class_install_properties (object_class, N_PROPERTIES, properties);
 
   /* Initialize debug category with nice colors */
@@ -131,7 +181,7 @@ gstd_session_init (GstdSession * self)
   GST_INFO_OBJECT (self, "Initializing gstd session");
 
   gstd_object_set_reader (GSTD_OBJECT(self),
-      g_object_new (GSTD_TYPE_PROPERTY_READER, NULL));
+      gstd_object_get_strategy (GSTD_TYPE_PROPERTY_READER));
 
   self->pipelines =
       GSTD_LIST (g_object_new (GSTD_TYPE_LIST, "name", "pipelines", "node-type",
@@ -140,18 +190,26 @@ gstd_session_init (GstdSession * self)
           GSTD_PARAM_DELETE, NULL));
 
   gstd_object_set_creator (GSTD_OBJECT(self->pipelines),
-      g_object_new (GSTD_TYPE_PIPELINE_CREATOR, NULL));
+      gstd_object_get_strategy (GSTD_TYPE_PIPELINE_CREATOR));
 
   gstd_object_set_reader (GSTD_OBJECT(self->pipelines),
-      g_object_new (GSTD_TYPE_LIST_READER, NULL));
+      gstd_object_get_strategy (GSTD_TYPE_LIST_READER));
 
   gstd_object_set_deleter (GSTD_OBJECT(self->pipelines),
-      g_object_new (GSTD_TYPE_PIPELINE_DELETER, NULL));
+      gstd_object_get_strategy (GSTD_TYPE_PIPELINE_DELETER));
 
   self->debug =
       GSTD_DEBUG (g_object_new (GSTD_TYPE_DEBUG, "name", "Debug", NULL));
 
   self->pid = (GPid) getpid ();
+
+  /* Entries own their key */
+  self->uri_cache = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+      gstd_session_cache_entry_free);
+  self->uri_cache_clock = g_queue_new ();
+  g_rw_lock_init (&self->uri_cache_lock);
+  self->uri_cache_hits = 0;
+  self->uri_cache_misses = 0;
 }
 
 static void
@@ -173,6 +231,12 @@ gstd_session_get_property (GObject * object,
       GST_DEBUG_OBJECT (self, "Returning debug object %p", self->debug);
       g_value_set_object (value, self->debug);
       break;
+    case PROP_URI_CACHE_HITS:
+      g_value_set_uint (value, g_atomic_int_get (&self->uri_cache_hits));
+      break;
+    case PROP_URI_CACHE_MISSES:
+      g_value_set_uint (value, g_atomic_int_get (&self->uri_cache_misses));
+      break;
 
     default:
       /* We don't have any other property... */
@@ -221,9 +285,194 @@ gstd_session_dispose (GObject * object)
     self->debug = NULL;
   }
 
+  g_rw_lock_writer_lock (&self->uri_cache_lock);
+  g_queue_clear (self->uri_cache_clock);
+  g_hash_table_remove_all (self->uri_cache);
+  g_rw_lock_writer_unlock (&self->uri_cache_lock);
+
   G_OBJECT_CLASS (gstd_session_parent_class)->dispose (object);
 }
 
+static void
+gstd_session_finalize (GObject * object)
+{
+  GstdSession *self = GSTD_SESSION (object);
+
+  g_queue_free (self->uri_cache_clock);
+  g_hash_table_destroy (self->uri_cache);
+  g_rw_lock_clear (&self->uri_cache_lock);
+
+  G_OBJECT_CLASS (gstd_session_parent_class)->finalize (object);
+}
+
+static void
+gstd_session_cache_entry_free (gpointer data)
+{
+  GstdSessionCacheEntry *entry = data;
+
+  gstd_session_cache_entry_clear (entry);
+  g_free (entry->key);
+  g_slice_free (GstdSessionCacheEntry, entry);
+}
+
+/* Points the entry at node, reached through lists as they were at the
+ * given generations */
+static void
+gstd_session_cache_entry_set (GstdSessionCacheEntry * entry,
+    GstdObject * node, GPtrArray * lists, GArray * generations)
+{
+  guint i;
+
+  g_weak_ref_init (&entry->node, node);
+
+  /* Weak references can't be moved, so the array is never resized */
+  entry->n_lists = lists->len;
+  entry->lists = g_new (GstdSessionCacheList, lists->len);
+  for (i = 0; i < lists->len; i++) {
+    g_weak_ref_init (&entry->lists[i].list, g_ptr_array_index (lists, i));
+    entry->lists[i].generation = g_array_index (generations, guint, i);
+  }
+
+  entry->referenced = FALSE;
+}
+
+static void
+gstd_session_cache_entry_clear (GstdSessionCacheEntry * entry)
+{
+  guint i;
+
+  g_weak_ref_clear (&entry->node);
+
+  for (i = 0; i < entry->n_lists; i++) {
+    g_weak_ref_clear (&entry->lists[i].list);
+  }
+  g_free (entry->lists);
+  entry->lists = NULL;
+  entry->n_lists = 0;
+}
+
+/* An entry holds as long as no list along its path changed */
+static gboolean
+gstd_session_cache_entry_is_valid (GstdSessionCacheEntry * entry)
+{
+  GObject *list;
+  gboolean valid;
+  guint i;
+
+  for (i = 0; i < entry->n_lists; i++) {
+    list = g_weak_ref_get (&entry->lists[i].list);
+    valid = list && gstd_list_get_generation (GSTD_LIST (list)) ==
+        entry->lists[i].generation;
+    if (list) {
+      g_object_unref (list);
+    }
+
+    if (!valid) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/* Drops empty segments, so "/pipelines//p0/" and "pipelines/p0" share
+ * the same entry */
+static gchar *
+gstd_session_normalize_uri (const gchar * uri)
+{
+  GString *normalized = g_string_sized_new (strlen (uri));
+  gsize length;
+
+  while (*uri) {
+    uri += strspn (uri, "/");
+    length = strcspn (uri, "/");
+    if (length) {
+      if (normalized->len) {
+        g_string_append_c (normalized, '/');
+      }
+      g_string_append_len (normalized, uri, length);
+      uri += length;
+    }
+  }
+
+  return g_string_free (normalized, FALSE);
+}
+
+/* Returns a new reference to the cached node, or NULL if it isn't cached,
+ * a list along its path changed since or the node is gone */
+static GstdObject *
+gstd_session_cache_lookup (GstdSession * self, const gchar * key)
+{
+  GstdSessionCacheEntry *entry;
+  GstdObject *node = NULL;
+
+  g_rw_lock_reader_lock (&self->uri_cache_lock);
+  entry = g_hash_table_lookup (self->uri_cache, key);
+  if (entry && gstd_session_cache_entry_is_valid (entry)) {
+    node = g_weak_ref_get (&entry->node);
+    if (node) {
+      g_atomic_int_set (&entry->referenced, TRUE);
+    }
+  }
+  g_rw_lock_reader_unlock (&self->uri_cache_lock);
+
+  return node;
+}
+
+/* Makes room for one entry with the clock algorithm. The hand sweeps the
+ * entries in the order they were inserted, dropping stale ones on the
+ * way, and evicts the first one that wasn't hit since its last pass.
+ * Called with the writer lock held. */
+static void
+gstd_session_cache_evict (GstdSession * self)
+{
+  GstdSessionCacheEntry *entry;
+  guint evicted = 0;
+
+  while (g_hash_table_size (self->uri_cache) >= GSTD_SESSION_URI_CACHE_SIZE) {
+    entry = g_queue_pop_head (self->uri_cache_clock);
+
+    if (entry->referenced && gstd_session_cache_entry_is_valid (entry)) {
+      entry->referenced = FALSE;
+      g_queue_push_tail (self->uri_cache_clock, entry);
+      continue;
+    }
+
+    g_hash_table_remove (self->uri_cache, entry->key);
+    evicted++;
+  }
+
+  if (evicted) {
+    GST_DEBUG_OBJECT (self, "URI cache full, evicted %u entries", evicted);
+  }
+}
+
+static void
+gstd_session_cache_insert (GstdSession * self, const gchar * key,
+    GstdObject * node, GPtrArray * lists, GArray * generations)
+{
+  GstdSessionCacheEntry *entry;
+
+  g_rw_lock_writer_lock (&self->uri_cache_lock);
+
+  /* A stale entry is refreshed in place, keeping its spot in the clock */
+  entry = g_hash_table_lookup (self->uri_cache, key);
+  if (entry) {
+    gstd_session_cache_entry_clear (entry);
+  } else {
+    gstd_session_cache_evict (self);
+
+    entry = g_slice_new0 (GstdSessionCacheEntry);
+    entry->key = g_strdup (key);
+    g_hash_table_insert (self->uri_cache, entry->key, entry);
+    g_queue_push_tail (self->uri_cache_clock, entry);
+  }
+
+  gstd_session_cache_entry_set (entry, node, lists, generations);
+
+  g_rw_lock_writer_unlock (&self->uri_cache_lock);
+}
+
 GstdSession *
 gstd_session_new (const gchar * name)
 {
@@ -246,12 +495,28 @@ gstd_get_by_uri (GstdSession * gstd, const gchar * uri, GstdObject ** node)
   GstdObject *parent, *child;
   gchar **nodes;
   gchar **it;
+  gchar *key;
+  GPtrArray *lists;
+  GArray *generations;
+  guint generation;
   GstdReturnCode ret;
 
   g_return_val_if_fail (GSTD_IS_SESSION (gstd), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (uri, GSTD_NULL_ARGUMENT);
 
-  nodes = g_strsplit_set (uri, "/", -1);
+  key = gstd_session_normalize_uri (uri);
+
+  parent = gstd_session_cache_lookup (gstd, key);
+  if (parent) {
+    g_atomic_int_inc (&gstd->uri_cache_hits);
+    g_free (key);
+    *node = parent;
+    return GSTD_EOK;
+  }
+
+  g_atomic_int_inc (&gstd->uri_cache_misses);
+
+  nodes = g_strsplit (key, "/", -1);
 
   if (!nodes)
     goto badcommand;
@@ -259,11 +524,16 @@ gstd_get_by_uri (GstdSession * gstd, const gchar * uri, GstdObject ** node)
   it = nodes;
   parent = g_object_ref (GSTD_OBJECT (gstd));
 
+  lists = g_ptr_array_new_with_free_func (g_object_unref);
+  generations = g_array_new (FALSE, FALSE, sizeof (guint));
+
   while (*it) {
-    // Empty slash, try no normalize
-    if ('\0' == *it[0]) {
-      ++it;
-      continue;
+    /* Read before walking on, so changes made meanwhile invalidate the
+     * entry */
+    if (GSTD_IS_LIST (parent)) {
+      generation = gstd_list_get_generation (GSTD_LIST (parent));
+      g_ptr_array_add (lists, g_object_ref (parent));
+      g_array_append_val (generations, generation);
     }
 
     ret = gstd_object_read (parent, *it, &child);
@@ -276,19 +546,32 @@ gstd_get_by_uri (GstdSession * gstd, const gchar * uri, GstdObject ** node)
     ++it;
   }
 
+  /* Nodes created on the fly for this read, such as bus messages or list
+   * counts, are only referenced by the caller and are never reused */
+  if (parent && gstd_object_is_cacheable (parent)) {
+    gstd_session_cache_insert (gstd, key, parent, lists, generations);
+  }
+
+  g_ptr_array_unref (lists);
+  g_array_unref (generations);
   g_strfreev(nodes);
+  g_free (key);
   *node = parent;
   return GSTD_EOK;
 
 badcommand:
   {
     GST_ERROR_OBJECT (gstd, "Invalid command");
+    g_free (key);
     return GSTD_BAD_COMMAND;
   }
 nonode:
   {
     GST_ERROR_OBJECT (gstd, "Invalid node %s", *it);
+    g_ptr_array_unref (lists);
+    g_array_unref (generations);
     g_strfreev(nodes);
+    g_free (key);
     return GSTD_BAD_COMMAND;
   }
 }
@@ -210,6 +210,17 @@ struct _GstdSession
    * Object containing debug options
    */
   GstdDebug *debug;
+
+  /*
+   * Nodes resolved by gstd_get_by_uri, indexed by normalized URI. The
+   * queue holds the same entries in the order the eviction clock visits
+   * them
+   */
+  GHashTable *uri_cache;
+  GQueue *uri_cache_clock;
+  GRWLock uri_cache_lock;
+  guint uri_cache_hits;
+  guint uri_cache_misses;
 };
 
 struct _GstdSessionClass
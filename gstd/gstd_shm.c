@@ -0,0 +1,582 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+/* memfd_create */
+#define _GNU_SOURCE
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/eventfd.h>
+#include <gst/gst.h>
+#include <glib/gstdio.h>
+#include <gio/gunixconnection.h>
+#include <gio/gunixsocketaddress.h>
+
+#include "gstd_shm.h"
+#include "gstd_parser.h"
+
+/* Gstd SHM debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_shm_debug);
+#define GST_CAT_DEFAULT gstd_shm_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/* The option parser may replace path, fall back to the default here so
+ * it never has to be freed behind its back */
+#define GSTD_SHM_PATH(self) \
+    ((self)->path ? (self)->path : GSTD_SHM_DEFAULT_PATH)
+
+struct _GstdShm
+{
+  GstdIpc parent;
+  gchar *path;
+  GSocketService *service;
+  GCancellable *cancellable;
+  gint clients;
+};
+
+struct _GstdShmClass
+{
+  GstdIpcClass parent_class;
+};
+
+/* The server side of a client session */
+typedef struct _GstdShmClient
+{
+  GstdShmLayout *layout;
+  gint server_bell;
+  gint client_bell;
+  GCancellable *cancellable;
+  GPollFD fds[3];
+} GstdShmClient;
+
+
+G_DEFINE_TYPE (GstdShm, gstd_shm, GSTD_TYPE_IPC);
+
+enum
+{
+  PROP_PATH = 1,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+
+/* VTable */
+
+static gboolean gstd_shm_incoming (GSocketService * service,
+    GSocketConnection * connection, GObject * source_object,
+    gpointer user_data);
+static gboolean gstd_shm_callback (GSocketService * service,
+    GSocketConnection * connection, GObject * source_object,
+    gpointer user_data);
+static gint gstd_shm_create_segment (gsize size);
+static gboolean gstd_shm_client_setup (GstdShm * self,
+    GstdShmClient * client, GSocketConnection * connection);
+static void gstd_shm_client_teardown (GstdShmClient * client);
+static gboolean gstd_shm_client_park (GstdShmClient * client,
+    GstdShmRing * ring, guint32 needed);
+static void gstd_shm_client_serve (GstdShm * self, GstdShmClient * client);
+static void gstd_shm_remove_socket_file (GstdShm * self);
+static void gstd_shm_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void gstd_shm_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_shm_dispose (GObject *);
+gboolean gstd_shm_init_get_option_group (GstdIpc * base,
+    GOptionGroup ** group);
+
+static void
+gstd_shm_class_init (GstdShmClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GstdIpcClass *gstdipc_class = GSTD_IPC_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+  object_class->set_property = gstd_shm_set_property;
+  object_class->get_property = gstd_shm_get_property;
+  object_class->dispose = gstd_shm_dispose;
+  gstdipc_class->start = GST_DEBUG_FUNCPTR (gstd_shm_start);
+  gstdipc_class->stop = GST_DEBUG_FUNCPTR (gstd_shm_stop);
+  gstdipc_class->get_option_group =
+      GST_DEBUG_FUNCPTR (gstd_shm_init_get_option_group);
+
+  properties[PROP_PATH] =
+      g_param_spec_string ("path",
+      "Path",
+      "The unix socket clients connect to in order to obtain their shared "
+      "memory segment",
+      GSTD_SHM_DEFAULT_PATH,
+      G_PARAM_READWRITE |
+      G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_shm_debug, "gstdshm", debug_color,
+      "Gstd SHM category");
+}
+
+static void
+gstd_shm_init (GstdShm * self)
+{
+  GST_INFO_OBJECT (self, "Initializing gstd Shm");
+  GstdIpc *base = GSTD_IPC (self);
+  self->path = NULL;
+  self->service = NULL;
+  self->cancellable = NULL;
+  self->clients = 0;
+  base->enabled = FALSE;
+}
+
+static void
+gstd_shm_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdShm *self = GSTD_SHM (object);
+
+  switch (property_id) {
+    case PROP_PATH:
+      GST_DEBUG_OBJECT (self, "Returning path %s", GSTD_SHM_PATH (self));
+      g_value_set_string (value, GSTD_SHM_PATH (self));
+      break;
+
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_shm_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdShm *self = GSTD_SHM (object);
+
+  switch (property_id) {
+    case PROP_PATH:
+      g_free (self->path);
+      self->path = g_value_dup_string (value);
+      GST_DEBUG_OBJECT (self, "Path changed to %s", GSTD_SHM_PATH (self));
+      break;
+
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_shm_dispose (GObject * object)
+{
+  GstdShm *self = GSTD_SHM (object);
+
+  GST_INFO_OBJECT (object, "Deinitializing gstd Shm");
+
+  g_free (self->path);
+  self->path = NULL;
+
+  G_OBJECT_CLASS (gstd_shm_parent_class)->dispose (object);
+}
+
+/* Returns an anonymous file of the given size, or -1 on failure */
+static gint
+gstd_shm_create_segment (gsize size)
+{
+  gint fd;
+#ifndef HAVE_MEMFD_CREATE
+  gchar *name;
+#endif
+
+#ifdef HAVE_MEMFD_CREATE
+  fd = memfd_create ("gstd-shm", MFD_CLOEXEC);
+#else
+  /* Fall back to an unlinked temporary file */
+  name = g_build_filename (g_get_tmp_dir (), "gstd-shm-XXXXXX", NULL);
+  fd = g_mkstemp_full (name, O_RDWR, 0600);
+  if (fd >= 0) {
+    g_unlink (name);
+  }
+  g_free (name);
+#endif
+
+  if (fd < 0) {
+    return -1;
+  }
+
+  if (ftruncate (fd, size) < 0) {
+    close (fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+/* Maps a fresh segment and hands it, along with both doorbells, to the
+ * client */
+static gboolean
+gstd_shm_client_setup (GstdShm * self, GstdShmClient * client,
+    GSocketConnection * connection)
+{
+  GUnixConnection *ucon = G_UNIX_CONNECTION (connection);
+  GError *error = NULL;
+  gint segment;
+
+  client->layout = MAP_FAILED;
+  client->server_bell = -1;
+  client->client_bell = -1;
+  client->cancellable = NULL;
+
+  segment = gstd_shm_create_segment (sizeof (GstdShmLayout));
+  if (segment < 0) {
+    GST_ERROR_OBJECT (self, "Unable to create segment: %s",
+        g_strerror (errno));
+    return FALSE;
+  }
+
+  client->layout = mmap (NULL, sizeof (GstdShmLayout),
+      PROT_READ | PROT_WRITE, MAP_SHARED, segment, 0);
+  client->server_bell = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+  client->client_bell = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+  if (MAP_FAILED == client->layout || client->server_bell < 0
+      || client->client_bell < 0) {
+    GST_ERROR_OBJECT (self, "Unable to set up client: %s",
+        g_strerror (errno));
+    close (segment);
+    return FALSE;
+  }
+
+  /* The segment comes zero filled, rings start out empty */
+  client->layout->magic = GSTD_SHM_MAGIC;
+  client->layout->version = GSTD_SHM_VERSION;
+  client->layout->ring_size = GSTD_SHM_RING_SIZE;
+
+  if (!g_unix_connection_send_fd (ucon, segment, NULL, &error)
+      || !g_unix_connection_send_fd (ucon, client->server_bell, NULL, &error)
+      || !g_unix_connection_send_fd (ucon, client->client_bell, NULL,
+          &error)) {
+    GST_ERROR_OBJECT (self, "Unable to send descriptors: %s",
+        error->message);
+    g_error_free (error);
+    close (segment);
+    return FALSE;
+  }
+
+  /* The mapping keeps the segment alive */
+  close (segment);
+
+  client->fds[0].fd = client->server_bell;
+  client->fds[0].events = G_IO_IN;
+  client->fds[1].fd =
+      g_socket_get_fd (g_socket_connection_get_socket (connection));
+  client->fds[1].events = G_IO_IN | G_IO_HUP | G_IO_ERR;
+
+  /* Wakes the client thread up when the server stops */
+  client->cancellable = g_object_ref (self->cancellable);
+  if (!g_cancellable_make_pollfd (client->cancellable, &client->fds[2])) {
+    GST_ERROR_OBJECT (self, "Unable to poll for the server stopping");
+    g_clear_object (&client->cancellable);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+static void
+gstd_shm_client_teardown (GstdShmClient * client)
+{
+  if (MAP_FAILED != client->layout) {
+    munmap (client->layout, sizeof (GstdShmLayout));
+  }
+  if (client->server_bell >= 0) {
+    close (client->server_bell);
+  }
+  if (client->client_bell >= 0) {
+    close (client->client_bell);
+  }
+  if (client->cancellable) {
+    g_cancellable_release_fd (client->cancellable);
+    g_object_unref (client->cancellable);
+  }
+}
+
+/* Blocks until the ring has a record (needed == 0) or enough free space
+ * for a record of needed bytes. Returns FALSE if the client went away or
+ * the server is stopping */
+static gboolean
+gstd_shm_client_park (GstdShmClient * client, GstdShmRing * ring,
+    guint32 needed)
+{
+  GstdShmLayout *layout = client->layout;
+  gboolean ready;
+
+  while (TRUE) {
+    g_atomic_int_set (&layout->server_waiting, 1);
+
+    /* Check again once the flag is visible, the client may have made
+     * progress right before it */
+    if (needed) {
+      ready = gstd_shm_ring_free_space (ring) >= needed;
+    } else {
+      ready = !gstd_shm_ring_is_empty (ring);
+    }
+
+    if (ready) {
+      g_atomic_int_set (&layout->server_waiting, 0);
+      return TRUE;
+    }
+
+    if (g_poll (client->fds, G_N_ELEMENTS (client->fds), -1) < 0
+        && EINTR != errno) {
+      break;
+    }
+
+    /* Nothing but a hang up is expected on the socket */
+    if (client->fds[1].revents || client->fds[2].revents) {
+      break;
+    }
+
+    gstd_shm_doorbell_clear (client->server_bell);
+  }
+
+  g_atomic_int_set (&layout->server_waiting, 0);
+  return FALSE;
+}
+
+static void
+gstd_shm_client_serve (GstdShm * self, GstdShmClient * client)
+{
+  GstdSession *session = GSTD_IPC (self)->session;
+  GstdShmLayout *layout = client->layout;
+  GstdReturnCode ret;
+  gchar *message;
+  gchar *output;
+  gchar *response;
+  guint32 length;
+
+  while (!g_cancellable_is_cancelled (client->cancellable)) {
+    message = gstd_shm_ring_pop (&layout->requests);
+    if (!message) {
+      if (!gstd_shm_client_park (client, &layout->requests, 0)) {
+        break;
+      }
+      continue;
+    }
+
+    /* Space was freed for a client blocked on a full request ring */
+    if (g_atomic_int_get (&layout->client_waiting)) {
+      gstd_shm_doorbell_ring (client->client_bell);
+    }
+
+    output = NULL;
+    ret = gstd_parser_parse_cmd (session, message, &output);
+    response = gstd_parser_envelope (ret, output, NULL);
+    g_free (output);
+    g_free (message);
+
+    length = strlen (response);
+    if (GSTD_SHM_RECORD_SIZE (length) > GSTD_SHM_RING_SIZE) {
+      GST_WARNING_OBJECT (self, "Response of %u bytes does not fit the ring",
+          length);
+      g_free (response);
+      response = gstd_parser_envelope (GSTD_IPC_ERROR, NULL, NULL);
+      length = strlen (response);
+    }
+
+    while (!gstd_shm_ring_push (&layout->responses, response, length)) {
+      if (!gstd_shm_client_park (client, &layout->responses,
+              GSTD_SHM_RECORD_SIZE (length))) {
+        g_free (response);
+        return;
+      }
+    }
+    g_free (response);
+
+    if (g_atomic_int_get (&layout->client_waiting)) {
+      gstd_shm_doorbell_ring (client->client_bell);
+    }
+  }
+}
+
+/* Runs in the listener, before a thread is handed the client. Clients
+ * beyond GSTD_SHM_MAX_CLIENTS are turned away by closing their connection
+ * before any descriptor is sent */
+static gboolean
+gstd_shm_incoming (GSocketService * service,
+    GSocketConnection * connection, GObject * source_object,
+    gpointer user_data)
+{
+  GstdShm *self = GSTD_SHM (user_data);
+
+  if (g_atomic_int_get (&self->clients) >= GSTD_SHM_MAX_CLIENTS) {
+    GST_WARNING_OBJECT (self, "Rejecting client, already serving %d",
+        GSTD_SHM_MAX_CLIENTS);
+    g_io_stream_close (G_IO_STREAM (connection), NULL, NULL);
+    return TRUE;
+  }
+
+  g_atomic_int_inc (&self->clients);
+
+  return FALSE;
+}
+
+/* Runs in its own thread for as long as the client keeps its connection
+ * open */
+static gboolean
+gstd_shm_callback (GSocketService * service,
+    GSocketConnection * connection, GObject * source_object,
+    gpointer user_data)
+{
+  GstdShm *self = GSTD_SHM (user_data);
+  GstdShmClient client;
+
+  g_return_val_if_fail (GSTD_IPC (self)->session, TRUE);
+
+  /* Responses are read by programs, not people */
+  gstd_object_set_pretty (FALSE);
+
+  if (gstd_shm_client_setup (self, &client, connection)) {
+    GST_DEBUG_OBJECT (self, "Serving shared memory client");
+    gstd_shm_client_serve (self, &client);
+    GST_DEBUG_OBJECT (self, "Shared memory client left");
+  }
+
+  gstd_shm_client_teardown (&client);
+  g_atomic_int_add (&self->clients, -1);
+
+  return FALSE;
+}
+
+/* Only remove what looks like a socket left behind by a previous run,
+ * never a regular file the user pointed us to by mistake */
+static void
+gstd_shm_remove_socket_file (GstdShm * self)
+{
+  GStatBuf buf;
+
+  if (0 == g_lstat (GSTD_SHM_PATH (self), &buf) && S_ISSOCK (buf.st_mode)) {
+    g_unlink (GSTD_SHM_PATH (self));
+  }
+}
+
+GstdReturnCode
+gstd_shm_start (GstdIpc * base, GstdSession * session)
+{
+  GstdShm *self = GSTD_SHM (base);
+  GSocketAddress *address;
+  GError *error = NULL;
+
+  if (!base->enabled) {
+    GST_DEBUG_OBJECT (self, "SHM not enabled, skipping");
+    return GSTD_EOK;
+  }
+
+  GST_DEBUG_OBJECT (self, "Starting SHM");
+
+  // Close any existing connection
+  gstd_shm_stop (base);
+
+  gstd_shm_remove_socket_file (self);
+
+  /* Each client is served by a dedicated thread spinning on its ring */
+  self->service = g_threaded_socket_service_new (GSTD_SHM_MAX_CLIENTS);
+  self->cancellable = g_cancellable_new ();
+
+  address = g_unix_socket_address_new (GSTD_SHM_PATH (self));
+  g_socket_listener_add_address (G_SOCKET_LISTENER (self->service), address,
+      G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_DEFAULT, NULL, NULL, &error);
+  g_object_unref (address);
+  if (error)
+    goto noconnection;
+
+  g_signal_connect (self->service, "incoming",
+      G_CALLBACK (gstd_shm_incoming), self);
+  g_signal_connect (self->service, "run", G_CALLBACK (gstd_shm_callback),
+      self);
+  g_socket_service_start (self->service);
+
+  return GSTD_EOK;
+
+noconnection:
+  {
+    GST_ERROR_OBJECT (session, "%s", error->message);
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    return GSTD_NO_CONNECTION;
+  }
+}
+
+GstdReturnCode
+gstd_shm_stop (GstdIpc * base)
+{
+  GstdShm *self = GSTD_SHM (base);
+  GstdSession *session = base->session;
+
+  g_return_val_if_fail (session, GSTD_NULL_ARGUMENT);
+
+  GST_DEBUG_OBJECT (self, "Entering SHM stop ");
+  if (self->service) {
+    GST_INFO_OBJECT (session, "Closing SHM connection for %s",
+        GSTD_OBJECT_NAME (session));
+    g_socket_listener_close (G_SOCKET_LISTENER (self->service));
+    g_socket_service_stop (self->service);
+    /* Client threads parked on their rings return */
+    g_cancellable_cancel (self->cancellable);
+    g_object_unref (self->service);
+    self->service = NULL;
+    g_clear_object (&self->cancellable);
+    gstd_shm_remove_socket_file (self);
+  }
+
+  return GSTD_EOK;
+}
+
+gboolean
+gstd_shm_init_get_option_group (GstdIpc * base, GOptionGroup ** group)
+{
+  GstdShm *self = GSTD_SHM (base);
+  GST_DEBUG_OBJECT (self, "SHM init group callback ");
+  GOptionEntry shm_args[] = {
+    {"enable-shm-protocol", 's', 0, G_OPTION_ARG_NONE, &base->enabled,
+        "Enable attach the server through shared memory", NULL}
+    ,
+    {"shm-path", 0, 0, G_OPTION_ARG_FILENAME, &self->path,
+          "Path of the unix socket handing out shared memory segments "
+          "(default " GSTD_SHM_DEFAULT_PATH ")",
+        "shm-path"}
+    ,
+    {NULL}
+  };
+  *group = g_option_group_new ("gstd-shm", ("Shared Memory Options"),
+      ("Show Shared Memory Options"), NULL, NULL);
+
+  g_option_group_add_entries (*group, shm_args);
+  return TRUE;
+}
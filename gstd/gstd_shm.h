@@ -0,0 +1,56 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_SHM_H__
+#define __GSTD_SHM_H__
+
+#include <gio/gio.h>
+#include "gstd_return_codes.h"
+#include "gstd_session.h"
+#include "gstd_ipc.h"
+#include "gstd_shm_ring.h"
+
+G_BEGIN_DECLS
+#define GSTD_SHM_DEFAULT_PATH "/tmp/gstd_shm_socket"
+/* Clients served at once, each one holds a thread and a segment */
+#define GSTD_SHM_MAX_CLIENTS 16
+#define GSTD_TYPE_SHM \
+  (gstd_shm_get_type())
+#define GSTD_SHM(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_SHM,GstdShm))
+#define GSTD_SHM_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_SHM,GstdShmClass))
+#define GSTD_IS_SHM(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_SHM))
+#define GSTD_IS_SHM_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_SHM))
+#define GSTD_SHM_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_SHM, GstdShmClass))
+typedef struct _GstdShm GstdShm;
+typedef struct _GstdShmClass GstdShmClass;
+GType gstd_shm_get_type ();
+
+
+GstdReturnCode gstd_shm_start (GstdIpc * base, GstdSession * session);
+
+GstdReturnCode gstd_shm_stop (GstdIpc * base);
+
+
+G_END_DECLS
+#endif //__GSTD_SHM_H__
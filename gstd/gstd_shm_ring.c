@@ -0,0 +1,169 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "gstd_shm_ring.h"
+
+static void gstd_shm_ring_copy_in (GstdShmRing * ring, guint32 pos,
+    gconstpointer src, guint32 length);
+static void gstd_shm_ring_copy_out (GstdShmRing * ring, guint32 pos,
+    gpointer dest, guint32 length);
+
+/* Positions grow forever and wrap around at 2^32, which is a multiple of
+ * the ring size, so only the offset within the ring needs masking */
+static void
+gstd_shm_ring_copy_in (GstdShmRing * ring, guint32 pos, gconstpointer src,
+    guint32 length)
+{
+  guint32 offset = pos & (GSTD_SHM_RING_SIZE - 1);
+  guint32 first = MIN (length, GSTD_SHM_RING_SIZE - offset);
+
+  memcpy (ring->data + offset, src, first);
+  memcpy (ring->data, (const guint8 *) src + first, length - first);
+}
+
+static void
+gstd_shm_ring_copy_out (GstdShmRing * ring, guint32 pos, gpointer dest,
+    guint32 length)
+{
+  guint32 offset = pos & (GSTD_SHM_RING_SIZE - 1);
+  guint32 first = MIN (length, GSTD_SHM_RING_SIZE - offset);
+
+  memcpy (dest, ring->data + offset, first);
+  memcpy ((guint8 *) dest + first, ring->data, length - first);
+}
+
+gboolean
+gstd_shm_ring_is_empty (GstdShmRing * ring)
+{
+  g_return_val_if_fail (ring, TRUE);
+
+  return g_atomic_int_get (&ring->head) == g_atomic_int_get (&ring->tail);
+}
+
+guint32
+gstd_shm_ring_free_space (GstdShmRing * ring)
+{
+  guint32 head;
+  guint32 tail;
+
+  g_return_val_if_fail (ring, 0);
+
+  head = (guint32) g_atomic_int_get (&ring->head);
+  tail = (guint32) g_atomic_int_get (&ring->tail);
+
+  return GSTD_SHM_RING_SIZE - (head - tail);
+}
+
+gboolean
+gstd_shm_ring_push (GstdShmRing * ring, const gchar * data, guint32 length)
+{
+  guint32 head;
+
+  g_return_val_if_fail (ring, FALSE);
+  g_return_val_if_fail (data, FALSE);
+
+  if (length > GSTD_SHM_RING_SIZE - sizeof (length)
+      || gstd_shm_ring_free_space (ring) < GSTD_SHM_RECORD_SIZE (length)) {
+    return FALSE;
+  }
+
+  head = (guint32) ring->head;
+  gstd_shm_ring_copy_in (ring, head, &length, sizeof (length));
+  gstd_shm_ring_copy_in (ring, head + sizeof (length), data, length);
+
+  /* Publish the record only once all of its bytes are in place */
+  g_atomic_int_set (&ring->head, (gint) (head + GSTD_SHM_RECORD_SIZE (length)));
+
+  return TRUE;
+}
+
+gchar *
+gstd_shm_ring_pop (GstdShmRing * ring)
+{
+  guint32 head;
+  guint32 tail;
+  guint32 length;
+  gchar *data;
+
+  g_return_val_if_fail (ring, NULL);
+
+  head = (guint32) g_atomic_int_get (&ring->head);
+  tail = (guint32) ring->tail;
+
+  if (head == tail) {
+    return NULL;
+  }
+
+  /* The peer is not trusted, a head further than a whole ring ahead
+   * can only come from a corrupt or hostile writer */
+  if (head - tail > GSTD_SHM_RING_SIZE || head - tail < sizeof (length)) {
+    g_warning ("Corrupt shared memory ring, %u bytes pending", head - tail);
+    g_atomic_int_set (&ring->tail, (gint) head);
+    return NULL;
+  }
+
+  gstd_shm_ring_copy_out (ring, tail, &length, sizeof (length));
+
+  /* Drop everything rather than reading past what was produced, padding
+   * included as push accounts for it. The first check keeps the record
+   * size from wrapping */
+  if (length > GSTD_SHM_RING_SIZE - sizeof (length)
+      || GSTD_SHM_RECORD_SIZE (length) > head - tail) {
+    g_warning ("Corrupt record of %u bytes in shared memory ring", length);
+    g_atomic_int_set (&ring->tail, (gint) head);
+    return NULL;
+  }
+
+  data = g_malloc (length + 1);
+  gstd_shm_ring_copy_out (ring, tail + sizeof (length), data, length);
+  data[length] = '\0';
+
+  g_atomic_int_set (&ring->tail, (gint) (tail + GSTD_SHM_RECORD_SIZE (length)));
+
+  return data;
+}
+
+void
+gstd_shm_doorbell_ring (gint fd)
+{
+  guint64 value = 1;
+
+  /* Writes only fail once the counter saturates, in which case the peer
+   * has plenty of wake ups pending anyway */
+  if (write (fd, &value, sizeof (value)) < 0) {
+    g_debug ("Doorbell %d saturated: %s", fd, g_strerror (errno));
+  }
+}
+
+void
+gstd_shm_doorbell_clear (gint fd)
+{
+  guint64 value;
+
+  /* EAGAIN just means there was nothing pending */
+  while (read (fd, &value, sizeof (value)) < 0 && EINTR == errno);
+}
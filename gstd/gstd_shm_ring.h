@@ -0,0 +1,125 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __GSTD_SHM_RING_H__
+#define __GSTD_SHM_RING_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+/*
+ * Shared memory layout used by the GstdShm IPC. A client connects to the
+ * GstdShm unix socket and receives three file descriptors, in order: the
+ * memory segment holding a #GstdShmLayout, the server doorbell and the
+ * client doorbell (both eventfds). The connection must stay open for as
+ * long as the client uses the segment, closing it ends the session.
+ *
+ * Commands go through the requests ring and responses come back through
+ * the responses ring. Each ring has a single producer and a single
+ * consumer. Records are a native endian 32 bit length followed by the
+ * payload, padded to 4 bytes.
+ *
+ * Before blocking on its doorbell, a side sets its waiting flag and
+ * checks the ring again. The other side only writes to a doorbell when
+ * it makes progress and sees the flag set, so a busy ring needs no
+ * syscalls at all.
+ */
+#define GSTD_SHM_MAGIC 0x4753484d
+#define GSTD_SHM_VERSION 1
+#define GSTD_SHM_RING_SIZE (256 * 1024)
+#define GSTD_SHM_CACHE_LINE 64
+#define GSTD_SHM_RECORD_SIZE(length) (4 + (((length) + 3) & ~3))
+typedef struct _GstdShmRing GstdShmRing;
+typedef struct _GstdShmLayout GstdShmLayout;
+
+struct _GstdShmRing
+{
+  /* Bytes ever produced, only written by the producer */
+  volatile gint head;
+  guint8 head_pad[GSTD_SHM_CACHE_LINE - sizeof (gint)];
+
+  /* Bytes ever consumed, only written by the consumer */
+  volatile gint tail;
+  guint8 tail_pad[GSTD_SHM_CACHE_LINE - sizeof (gint)];
+
+  guint8 data[GSTD_SHM_RING_SIZE];
+};
+
+struct _GstdShmLayout
+{
+  guint32 magic;
+  guint32 version;
+  guint32 ring_size;
+
+  /* Set by each side right before blocking on its doorbell */
+  volatile gint server_waiting;
+  volatile gint client_waiting;
+  guint8 pad[GSTD_SHM_CACHE_LINE - 5 * sizeof (guint32)];
+
+  GstdShmRing requests;
+  GstdShmRing responses;
+};
+
+/**
+ * gstd_shm_ring_push:
+ * @ring: The ring to produce into
+ * @data: The payload
+ * @length: The size of the payload in bytes
+ *
+ * Appends a record to the ring. Must only be called by the producer.
+ *
+ * Returns: FALSE if there is not enough free space for the record
+ */
+gboolean gstd_shm_ring_push (GstdShmRing * ring, const gchar * data,
+    guint32 length);
+
+/**
+ * gstd_shm_ring_pop:
+ * @ring: The ring to consume from
+ *
+ * Removes the oldest record from the ring. Must only be called by the
+ * consumer.
+ *
+ * Returns: (transfer full) (nullable): The NUL terminated payload, or
+ * NULL if the ring is empty. Free with g_free after usage
+ */
+gchar *gstd_shm_ring_pop (GstdShmRing * ring);
+
+gboolean gstd_shm_ring_is_empty (GstdShmRing * ring);
+
+guint32 gstd_shm_ring_free_space (GstdShmRing * ring);
+
+/**
+ * gstd_shm_doorbell_ring:
+ * @fd: The eventfd of the side to wake up
+ *
+ * Wakes up the peer blocked on @fd.
+ */
+void gstd_shm_doorbell_ring (gint fd);
+
+/**
+ * gstd_shm_doorbell_clear:
+ * @fd: The eventfd of the calling side
+ *
+ * Resets the doorbell after waking up, @fd must be non blocking.
+ */
+void gstd_shm_doorbell_clear (gint fd);
+
+G_END_DECLS
+#endif //__GSTD_SHM_RING_H__
@@ -0,0 +1,1314 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_socket.h"
+#include "gstd_parser.h"
+#include "gstd_cbor_writer.h"
+
+/* Gstd Socket debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_socket_debug);
+#define GST_CAT_DEFAULT gstd_socket_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+typedef struct _GstdSocketConnection GstdSocketConnection;
+
+/* A client request. Tagged requests carry the id supplied by the client
+ * and may complete out of order, untagged ones are executed alone */
+typedef struct _GstdSocketRequest
+{
+  GstdSocketConnection *conn;
+  gchar *id;
+  gchar *message;
+  gchar *response;
+  gboolean framed;
+  gboolean compact;
+  gboolean binary;
+} GstdSocketRequest;
+
+/* A property watched by a connection, along with the URI the client
+ * used to refer to it */
+typedef struct _GstdSocketWatch
+{
+  GstdSocketConnection *conn;
+  gchar *uri;
+  GstdPropertyWatch *watch;
+} GstdSocketWatch;
+
+/* A client connection. It is only touched from the reactor, requests
+ * belong to the worker while they are being executed */
+struct _GstdSocketConnection
+{
+  GstdSocket *socket;
+  GSocketConnection *connection;
+  GInputStream *istream;
+  GOutputStream *ostream;
+  GCancellable *cancellable;
+  /* Abandons requests still waiting once the client hangs up */
+  GCancellable *pending;
+  /* Set once bus_subscribe turns the connection into a stream */
+  GstdPipelineBusSubscription *subscription;
+  GSource *wakeup;
+  /* Properties whose changes are pushed to the client */
+  GList *watches;
+  GByteArray *input;
+  GstdSocketRequest *next;
+  GQueue *responses;
+  guint inflight;
+  gboolean barrier;
+  gboolean served;
+  gboolean reading;
+  gboolean writing;
+  gboolean eof;
+  gboolean closing;
+  gboolean partial;
+  gboolean framed;
+  gboolean compact;
+  gboolean binary;
+  gboolean broken;
+  guint8 header[GSTD_SOCKET_FRAME_HEADER_SIZE];
+  guint8 chunk[GSTD_SOCKET_CHUNK_SIZE];
+};
+
+G_DEFINE_ABSTRACT_TYPE (GstdSocket, gstd_socket, GSTD_TYPE_IPC);
+
+enum
+{
+  PROP_KEEP_ALIVE = 1,
+  PROP_IDLE_TIMEOUT = 2,
+  PROP_NUM_WORKERS = 3,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+
+/* VTable */
+
+static gboolean
+gstd_socket_callback (GSocketService * service,
+    GSocketConnection * connection,
+    GObject * source_object, gpointer user_data);
+static GstdSocketConnection *gstd_socket_connection_new (GstdSocket * self,
+    GSocketConnection * connection);
+static void gstd_socket_connection_free (GstdSocketConnection * conn);
+static void gstd_socket_connection_close (GstdSocketConnection * conn);
+static void gstd_socket_connection_release (GstdSocketConnection * conn);
+static void gstd_socket_connection_read (GstdSocketConnection * conn);
+static void gstd_socket_connection_write (GstdSocketConnection * conn,
+    GstdSocketRequest * req);
+static gchar *gstd_socket_connection_next_message (GstdSocketConnection * conn);
+static gboolean gstd_socket_connection_control (GstdSocketConnection * conn,
+    GstdSocketRequest * req);
+static void gstd_socket_connection_pump (GstdSocketConnection * conn);
+static void gstd_socket_watch_free (GstdSocketWatch * watch);
+static GstdSocketRequest *gstd_socket_request_new (GstdSocketConnection * conn,
+    gchar * message);
+static void gstd_socket_request_free (GstdSocketRequest * req);
+static gboolean gstd_socket_request_parse_id (GstdSocketRequest * req);
+static void gstd_socket_read_cb (GObject * source, GAsyncResult * result,
+    gpointer user_data);
+static void gstd_socket_worker (gpointer data, gpointer user_data);
+static void gstd_socket_worker_ready (GstdReturnCode ret, gchar * output,
+    gpointer user_data);
+static gboolean gstd_socket_worker_done (gpointer user_data);
+static void gstd_socket_write_header_cb (GObject * source,
+    GAsyncResult * result, gpointer user_data);
+static void gstd_socket_write_cb (GObject * source, GAsyncResult * result,
+    gpointer user_data);
+static gpointer gstd_socket_reactor (gpointer user_data);
+static gboolean gstd_socket_shutdown (gpointer user_data);
+
+static void gstd_socket_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void gstd_socket_get_property (GObject *, guint, GValue *,
+    GParamSpec *);
+static void gstd_socket_dispose (GObject *);
+
+static void
+gstd_socket_class_init (GstdSocketClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GstdIpcClass *gstdipc_class = GSTD_IPC_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+  object_class->set_property = gstd_socket_set_property;
+  object_class->get_property = gstd_socket_get_property;
+  gstdipc_class->start = GST_DEBUG_FUNCPTR (gstd_socket_start);
+  gstdipc_class->stop = GST_DEBUG_FUNCPTR (gstd_socket_stop);
+  object_class->dispose = gstd_socket_dispose;
+
+  properties[PROP_KEEP_ALIVE] =
+      g_param_spec_boolean ("keep-alive",
+      "Keep Alive",
+      "Keep connections open and serve NUL or newline terminated commands "
+      "until the client closes or goes idle",
+      GSTD_SOCKET_DEFAULT_KEEP_ALIVE,
+      G_PARAM_READWRITE |
+      G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_IDLE_TIMEOUT] =
+      g_param_spec_uint ("idle-timeout",
+      "Idle Timeout",
+      "Seconds a connection may stay idle before being closed, "
+      "0 to wait forever",
+      0,
+      G_MAXINT,
+      GSTD_SOCKET_DEFAULT_IDLE_TIMEOUT,
+      G_PARAM_READWRITE |
+      G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  properties[PROP_NUM_WORKERS] =
+      g_param_spec_uint ("num-workers",
+      "Num Workers",
+      "The number of threads executing commands, 0 to use one per CPU",
+      0,
+      G_MAXINT,
+      GSTD_SOCKET_DEFAULT_NUM_WORKERS,
+      G_PARAM_READWRITE |
+      G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_socket_debug, "gstdsocket", debug_color,
+      "Gstd Socket category");
+}
+
+static void
+gstd_socket_init (GstdSocket * self)
+{
+  GST_INFO_OBJECT (self, "Initializing gstd Socket");
+  self->keep_alive = GSTD_SOCKET_DEFAULT_KEEP_ALIVE;
+  self->idle_timeout = GSTD_SOCKET_DEFAULT_IDLE_TIMEOUT;
+  self->num_workers = GSTD_SOCKET_DEFAULT_NUM_WORKERS;
+  self->service = NULL;
+  self->context = NULL;
+  self->loop = NULL;
+  self->reactor = NULL;
+  self->workers = NULL;
+  self->connections = NULL;
+  self->stopping = FALSE;
+}
+
+static void
+gstd_socket_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdSocket *self = GSTD_SOCKET (object);
+
+  switch (property_id) {
+    case PROP_KEEP_ALIVE:
+      GST_DEBUG_OBJECT (self, "Returning keep-alive %d", self->keep_alive);
+      g_value_set_boolean (value, self->keep_alive);
+      break;
+    case PROP_IDLE_TIMEOUT:
+      GST_DEBUG_OBJECT (self, "Returning idle-timeout %u", self->idle_timeout);
+      g_value_set_uint (value, self->idle_timeout);
+      break;
+    case PROP_NUM_WORKERS:
+      GST_DEBUG_OBJECT (self, "Returning num-workers %u", self->num_workers);
+      g_value_set_uint (value, self->num_workers);
+      break;
+
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_socket_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdSocket *self = GSTD_SOCKET (object);
+
+  switch (property_id) {
+    case PROP_KEEP_ALIVE:
+      self->keep_alive = g_value_get_boolean (value);
+      GST_DEBUG_OBJECT (self, "Keep-alive changed to %d", self->keep_alive);
+      break;
+    case PROP_IDLE_TIMEOUT:
+      self->idle_timeout = g_value_get_uint (value);
+      GST_DEBUG_OBJECT (self, "Idle-timeout changed to %u", self->idle_timeout);
+      break;
+    case PROP_NUM_WORKERS:
+      self->num_workers = g_value_get_uint (value);
+      GST_DEBUG_OBJECT (self, "Num-workers changed to %u", self->num_workers);
+      break;
+
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+/* Parses a non negative option value, as the matching properties
+ * are unsigned and bounded to G_MAXINT */
+static gboolean
+gstd_socket_parse_option (const gchar * option_name, const gchar * value,
+    guint * out, GError ** error)
+{
+  guint64 number;
+  gchar *end;
+
+  if (!g_ascii_isdigit (value[0])) {
+    goto error;
+  }
+
+  number = g_ascii_strtoull (value, &end, 10);
+  if ('\0' != end[0] || number > G_MAXINT) {
+    goto error;
+  }
+
+  *out = number;
+  return TRUE;
+
+error:
+  g_set_error (error, G_OPTION_ERROR, G_OPTION_ERROR_BAD_VALUE,
+      "Cannot parse value \"%s\" for %s, expected a number between 0 and %d",
+      value, option_name, G_MAXINT);
+  return FALSE;
+}
+
+gboolean
+gstd_socket_parse_idle_timeout (const gchar * option_name,
+    const gchar * value, gpointer data, GError ** error)
+{
+  GstdSocket *self = GSTD_SOCKET (data);
+
+  return gstd_socket_parse_option (option_name, value, &self->idle_timeout,
+      error);
+}
+
+gboolean
+gstd_socket_parse_num_workers (const gchar * option_name,
+    const gchar * value, gpointer data, GError ** error)
+{
+  GstdSocket *self = GSTD_SOCKET (data);
+
+  return gstd_socket_parse_option (option_name, value, &self->num_workers,
+      error);
+}
+
+static void
+gstd_socket_dispose (GObject * object)
+{
+  GstdSocket *self = GSTD_SOCKET (object);
+
+  GST_INFO_OBJECT (object, "Deinitializing gstd Socket");
+
+  if (self->service) {
+    self->service = NULL;
+  }
+
+  G_OBJECT_CLASS (gstd_socket_parent_class)->dispose (object);
+}
+
+static gboolean
+gstd_socket_callback (GSocketService * service,
+    GSocketConnection * connection, GObject * source_object, gpointer user_data)
+{
+  GstdSocket *self = GSTD_SOCKET (user_data);
+  GstdSocketConnection *conn;
+
+  g_return_val_if_fail (GSTD_IPC (self)->session, TRUE);
+
+  conn = gstd_socket_connection_new (self, connection);
+
+  /* Pending reads will fail with G_IO_ERROR_TIMED_OUT once the client
+   * has been idle for too long, which closes the connection. Oneshot
+   * connections need it as well, in case their command happened to fill
+   * whole chunks, see gstd_socket_read_cb() */
+  g_socket_set_timeout (g_socket_connection_get_socket (connection),
+      self->idle_timeout);
+  if (self->keep_alive) {
+    GST_DEBUG_OBJECT (self, "Serving keep-alive connection");
+  }
+
+  gstd_socket_connection_pump (conn);
+
+  return TRUE;
+}
+
+static GstdSocketRequest *
+gstd_socket_request_new (GstdSocketConnection * conn, gchar * message)
+{
+  GstdSocketRequest *req;
+
+  req = g_slice_new0 (GstdSocketRequest);
+  req->conn = conn;
+  req->message = message;
+  /* Replies go out in the protocol and format the request came in */
+  req->framed = conn->framed;
+  req->compact = conn->compact;
+  req->binary = conn->binary;
+
+  return req;
+}
+
+static void
+gstd_socket_request_free (GstdSocketRequest * req)
+{
+  g_free (req->id);
+  g_free (req->message);
+  g_free (req->response);
+  g_slice_free (GstdSocketRequest, req);
+}
+
+/* Splits the optional "#<id>" prefix off the request message. Returns
+ * FALSE if the prefix is not a decimal number */
+static gboolean
+gstd_socket_request_parse_id (GstdSocketRequest * req)
+{
+  gchar *message = req->message;
+  gchar *end;
+
+  if ('#' != message[0]) {
+    return TRUE;
+  }
+
+  end = message + 1 + strspn (message + 1, "0123456789");
+  if (end == message + 1 || ('\0' != end[0] && !g_ascii_isspace (end[0]))) {
+    return FALSE;
+  }
+
+  req->id = g_strndup (message + 1, end - message - 1);
+
+  end += strspn (end, " \t");
+  memmove (message, end, strlen (end) + 1);
+
+  return TRUE;
+}
+
+static GstdSocketConnection *
+gstd_socket_connection_new (GstdSocket * self, GSocketConnection * connection)
+{
+  GstdSocketConnection *conn;
+
+  conn = g_slice_new0 (GstdSocketConnection);
+  conn->socket = self;
+  conn->connection = g_object_ref (connection);
+  conn->istream = g_io_stream_get_input_stream (G_IO_STREAM (connection));
+  conn->ostream = g_io_stream_get_output_stream (G_IO_STREAM (connection));
+  conn->cancellable = g_cancellable_new ();
+  conn->pending = g_cancellable_new ();
+  conn->input = g_byte_array_new ();
+  conn->responses = g_queue_new ();
+
+  self->connections = g_list_prepend (self->connections, conn);
+
+  return conn;
+}
+
+static void
+gstd_socket_connection_free (GstdSocketConnection * conn)
+{
+  g_io_stream_close (G_IO_STREAM (conn->connection), NULL, NULL);
+  g_object_unref (conn->connection);
+  g_object_unref (conn->cancellable);
+  g_object_unref (conn->pending);
+  g_byte_array_free (conn->input, TRUE);
+  g_queue_free_full (conn->responses, (GDestroyNotify) gstd_socket_request_free);
+  if (conn->next) {
+    gstd_socket_request_free (conn->next);
+  }
+  g_slice_free (GstdSocketConnection, conn);
+}
+
+/* Cancels pending operations, the connection is freed once the last of
+ * them and every running request is done */
+static void
+gstd_socket_connection_close (GstdSocketConnection * conn)
+{
+  conn->closing = TRUE;
+  g_cancellable_cancel (conn->cancellable);
+  g_cancellable_cancel (conn->pending);
+
+  if (conn->subscription) {
+    gstd_pipeline_bus_unsubscribe (conn->subscription);
+    conn->subscription = NULL;
+    g_source_destroy (conn->wakeup);
+    g_source_unref (conn->wakeup);
+    conn->wakeup = NULL;
+  }
+
+  g_list_free_full (conn->watches, (GDestroyNotify) gstd_socket_watch_free);
+  conn->watches = NULL;
+
+  gstd_socket_connection_release (conn);
+}
+
+static void
+gstd_socket_connection_release (GstdSocketConnection * conn)
+{
+  GstdSocket *self = conn->socket;
+
+  if (conn->reading || conn->writing || conn->inflight) {
+    return;
+  }
+
+  self->connections = g_list_remove (self->connections, conn);
+  gstd_socket_connection_free (conn);
+
+  if (self->stopping && !self->connections) {
+    g_main_loop_quit (self->loop);
+  }
+}
+
+static void
+gstd_socket_connection_read (GstdSocketConnection * conn)
+{
+  conn->reading = TRUE;
+  g_input_stream_read_async (conn->istream, conn->chunk, sizeof (conn->chunk),
+      G_PRIORITY_DEFAULT, conn->cancellable, gstd_socket_read_cb, conn);
+}
+
+/* Framed responses go out as their length header followed by the
+ * payload, text responses are NUL terminated */
+static void
+gstd_socket_connection_write (GstdSocketConnection * conn, GstdSocketRequest * req)
+{
+  gsize length;
+
+  conn->writing = TRUE;
+
+  /* Binary responses already are complete frames */
+  if (req->binary) {
+    g_output_stream_write_all_async (conn->ostream, req->response,
+        gstd_cbor_writer_get_size (req->response), G_PRIORITY_DEFAULT,
+        conn->cancellable, gstd_socket_write_cb, req);
+    return;
+  }
+
+  length = strlen (req->response);
+
+  if (req->framed) {
+    GST_WRITE_UINT32_BE (conn->header, length);
+    g_output_stream_write_all_async (conn->ostream, conn->header,
+        GSTD_SOCKET_FRAME_HEADER_SIZE, G_PRIORITY_DEFAULT, conn->cancellable,
+        gstd_socket_write_header_cb, req);
+  } else {
+    g_output_stream_write_all_async (conn->ostream, req->response,
+        length + 1, G_PRIORITY_DEFAULT, conn->cancellable,
+        gstd_socket_write_cb, req);
+  }
+}
+
+/* Extracts the next command from the buffered input. Framed commands are
+ * preceded by their length, text commands are terminated by a NUL or a
+ * newline character. In oneshot mode whatever arrived before the client
+ * paused is the command, as it always has been */
+static gchar *
+gstd_socket_connection_next_message (GstdSocketConnection * conn)
+{
+  GByteArray *input = conn->input;
+  guint8 *end;
+  guint8 *newline;
+  guint32 length;
+  gchar *message;
+
+  if (0 == input->len) {
+    return NULL;
+  }
+
+  if (conn->framed) {
+    if (input->len < GSTD_SOCKET_FRAME_HEADER_SIZE) {
+      return NULL;
+    }
+
+    length = GST_READ_UINT32_BE (input->data);
+    if (length > GSTD_SOCKET_MAX_FRAME_SIZE) {
+      GST_WARNING_OBJECT (conn->socket, "Frame of %u bytes exceeds the maximum "
+          "of %u", length, GSTD_SOCKET_MAX_FRAME_SIZE);
+      conn->broken = TRUE;
+      return NULL;
+    }
+
+    if (input->len - GSTD_SOCKET_FRAME_HEADER_SIZE < length) {
+      return NULL;
+    }
+
+    message = g_strndup ((gchar *) input->data + GSTD_SOCKET_FRAME_HEADER_SIZE,
+        length);
+    g_byte_array_remove_range (input, 0, GSTD_SOCKET_FRAME_HEADER_SIZE + length);
+
+    return message;
+  }
+
+  end = memchr (input->data, '\0', input->len);
+  newline = memchr (input->data, '\n', end ? end - input->data : input->len);
+  if (newline) {
+    end = newline;
+  }
+
+  if (end) {
+    length = end - input->data;
+  } else if (conn->eof || (!conn->socket->keep_alive && !conn->partial)) {
+    length = input->len;
+  } else if (input->len > GSTD_SOCKET_MAX_FRAME_SIZE) {
+    /* Text commands are held to the size of frames too */
+    GST_WARNING_OBJECT (conn->socket, "Unterminated command of %u bytes "
+        "exceeds the maximum of %u", input->len, GSTD_SOCKET_MAX_FRAME_SIZE);
+    conn->broken = TRUE;
+    return NULL;
+  } else {
+    return NULL;
+  }
+
+  message = g_strndup ((gchar *) input->data, length);
+  g_byte_array_remove_range (input, 0, MIN (length + 1, input->len));
+
+  return message;
+}
+
+/* Returns the arguments of message if its command is verb, NULL
+ * otherwise */
+static gchar *
+gstd_socket_control_args (gchar * message, const gchar * verb)
+{
+  if (!g_str_has_prefix (message, verb)) {
+    return NULL;
+  }
+
+  message += strlen (verb);
+  if (message[0] && !g_ascii_isspace (message[0])) {
+    return NULL;
+  }
+
+  return message + strspn (message, " \t");
+}
+
+static GstdReturnCode
+gstd_socket_connection_protocol (GstdSocketConnection * conn,
+    const gchar * args)
+{
+  GstdSocket *self = conn->socket;
+
+  if ('\0' == args[0]) {
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  if (strcmp (args, "framed")) {
+    return GSTD_BAD_VALUE;
+  }
+
+  /* Framed connections are always persistent. The reply itself is
+   * still sent as text */
+  GST_DEBUG_OBJECT (self, "Switching connection to framed protocol");
+  g_socket_set_timeout (g_socket_connection_get_socket (conn->connection),
+      self->idle_timeout);
+  conn->framed = TRUE;
+
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_socket_connection_format (GstdSocketConnection * conn,
+    const gchar * args)
+{
+  if ('\0' == args[0]) {
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  if (!strcmp (args, "compact")) {
+    conn->compact = TRUE;
+    conn->binary = FALSE;
+  } else if (!strcmp (args, "pretty")) {
+    conn->compact = FALSE;
+    conn->binary = FALSE;
+  } else if (!strcmp (args, "cbor") && conn->framed) {
+    /* Binary responses need frames to carry their size */
+    conn->binary = TRUE;
+  } else {
+    return GSTD_BAD_VALUE;
+  }
+
+  GST_DEBUG_OBJECT (conn->socket, "Switching connection to %s responses",
+      args);
+
+  return GSTD_EOK;
+}
+
+/* Called from the thread posting the message, the connection itself
+ * can't be touched from here */
+static void
+gstd_socket_connection_notify (GstdPipelineBusSubscription * sub,
+    gpointer user_data)
+{
+  g_source_set_ready_time ((GSource *) user_data, 0);
+}
+
+static gboolean
+gstd_socket_wakeup_dispatch (GSource * source, GSourceFunc callback,
+    gpointer user_data)
+{
+  g_source_set_ready_time (source, -1);
+
+  return callback (user_data);
+}
+
+static GSourceFuncs gstd_socket_wakeup_funcs = {
+  NULL, NULL, gstd_socket_wakeup_dispatch, NULL
+};
+
+static gboolean
+gstd_socket_connection_wakeup (gpointer user_data)
+{
+  gstd_socket_connection_pump (user_data);
+
+  return G_SOURCE_CONTINUE;
+}
+
+/* Turns the connection into a stream of the matching bus messages. No
+ * further commands are served on it */
+static GstdReturnCode
+gstd_socket_connection_subscribe (GstdSocketConnection * conn, gchar * args)
+{
+  GstdSocket *self = conn->socket;
+  GstdReturnCode ret;
+  GSource *wakeup;
+
+  wakeup = g_source_new (&gstd_socket_wakeup_funcs, sizeof (GSource));
+  g_source_set_callback (wakeup, gstd_socket_connection_wakeup, conn, NULL);
+
+  ret = gstd_parser_bus_subscribe (GSTD_IPC (self)->session, args,
+      GSTD_SOCKET_MAX_QUEUED_MESSAGES, gstd_socket_connection_notify,
+      g_source_ref (wakeup), (GDestroyNotify) g_source_unref,
+      &conn->subscription);
+  if (ret) {
+    g_source_unref (wakeup);
+    g_source_unref (wakeup);
+    return ret;
+  }
+
+  g_source_attach (wakeup, self->context);
+  conn->wakeup = wakeup;
+
+  /* Streams stay open for as long as the client wants them */
+  g_socket_set_timeout (g_socket_connection_get_socket (conn->connection), 0);
+  GST_DEBUG_OBJECT (self, "Connection subscribed to bus messages");
+
+  return GSTD_EOK;
+}
+
+static void
+gstd_socket_watch_free (GstdSocketWatch * watch)
+{
+  gstd_property_unwatch (watch->watch);
+  g_free (watch->uri);
+  g_slice_free (GstdSocketWatch, watch);
+}
+
+/* Called from the reactor once a watched property changed. Updates are
+ * dropped while the client is too far behind, the next change reports
+ * the latest value anyway */
+static void
+gstd_socket_watch_changed (GstdPropertyWatch * property_watch,
+    gpointer user_data)
+{
+  GstdSocketWatch *watch = user_data;
+  GstdSocketConnection *conn = watch->conn;
+  GstdSocketRequest *req;
+
+  if (conn->closing || conn->broken) {
+    return;
+  }
+
+  if (g_queue_get_length (conn->responses) >= GSTD_SOCKET_MAX_QUEUED_MESSAGES) {
+    GST_DEBUG_OBJECT (conn->socket, "Client behind, dropping update of %s",
+        watch->uri);
+    return;
+  }
+
+  gstd_object_set_pretty (!conn->compact);
+  gstd_object_set_binary (conn->binary);
+
+  req = gstd_socket_request_new (conn, NULL);
+  req->response = gstd_parser_watch_event (watch->uri, property_watch);
+  g_queue_push_tail (conn->responses, req);
+
+  gstd_socket_connection_pump (conn);
+}
+
+/* Pushes the changes of a property to the client, along with the
+ * replies to its commands */
+static GstdReturnCode
+gstd_socket_connection_watch (GstdSocketConnection * conn, gchar * args)
+{
+  GstdSocket *self = conn->socket;
+  GstdSocketWatch *watch;
+  GstdReturnCode ret;
+
+  if ('\0' == args[0]) {
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  watch = g_slice_new0 (GstdSocketWatch);
+  watch->conn = conn;
+  watch->uri = g_strndup (args, strcspn (args, " \t"));
+
+  ret = gstd_parser_watch (GSTD_IPC (self)->session, args, self->context,
+      gstd_socket_watch_changed, watch, NULL, &watch->watch);
+  if (ret) {
+    g_free (watch->uri);
+    g_slice_free (GstdSocketWatch, watch);
+    return ret;
+  }
+
+  conn->watches = g_list_prepend (conn->watches, watch);
+
+  /* Watching clients may stay quiet for as long as they want */
+  g_socket_set_timeout (g_socket_connection_get_socket (conn->connection), 0);
+  GST_DEBUG_OBJECT (self, "Connection watching %s", watch->uri);
+
+  return GSTD_EOK;
+}
+
+static GstdReturnCode
+gstd_socket_connection_unwatch (GstdSocketConnection * conn,
+    const gchar * args)
+{
+  GstdSocket *self = conn->socket;
+  GstdSocketWatch *watch;
+  GList *l;
+
+  if ('\0' == args[0]) {
+    return GSTD_MISSING_ARGUMENT;
+  }
+
+  for (l = conn->watches; l; l = l->next) {
+    watch = l->data;
+    if (!strcmp (watch->uri, args)) {
+      break;
+    }
+  }
+
+  if (!l) {
+    return GSTD_NO_RESOURCE;
+  }
+
+  conn->watches = g_list_delete_link (conn->watches, l);
+  gstd_socket_watch_free (watch);
+
+  if (!conn->watches) {
+    g_socket_set_timeout (g_socket_connection_get_socket (conn->connection),
+        self->idle_timeout);
+  }
+
+  return GSTD_EOK;
+}
+
+/* Handles commands addressed to the connection itself rather than to the
+ * session. Returns TRUE if req was one of them, its reply is queued */
+static gboolean
+gstd_socket_connection_control (GstdSocketConnection * conn, GstdSocketRequest * req)
+{
+  GstdReturnCode ret;
+  gchar *args;
+
+  if ((args = gstd_socket_control_args (req->message, "protocol"))) {
+    ret = gstd_socket_connection_protocol (conn, args);
+  } else if ((args = gstd_socket_control_args (req->message, "format"))) {
+    ret = gstd_socket_connection_format (conn, args);
+  } else if ((args = gstd_socket_control_args (req->message,
+              "bus_subscribe"))) {
+    ret = gstd_socket_connection_subscribe (conn, args);
+  } else if ((args = gstd_socket_control_args (req->message, "watch"))) {
+    ret = gstd_socket_connection_watch (conn, args);
+  } else if ((args = gstd_socket_control_args (req->message, "unwatch"))) {
+    ret = gstd_socket_connection_unwatch (conn, args);
+  } else {
+    return FALSE;
+  }
+
+  /* The reply already follows a format change, and must be written the
+   * way it was built. A protocol change still answers in text */
+  req->compact = conn->compact;
+  req->binary = conn->binary;
+  gstd_object_set_pretty (!req->compact);
+  gstd_object_set_binary (req->binary);
+  req->response = gstd_parser_envelope (ret, NULL, NULL);
+  g_queue_push_tail (conn->responses, req);
+
+  return TRUE;
+}
+
+/* Queues the next pushed message of a stream once everything before it
+ * has been written. Messages wait in the bounded subscription queue
+ * while the client is slow */
+static void
+gstd_socket_connection_stream (GstdSocketConnection * conn)
+{
+  GstdSocketRequest *req;
+  GstMessage *message;
+  guint dropped;
+
+  if (!conn->subscription || conn->writing
+      || !g_queue_is_empty (conn->responses)) {
+    return;
+  }
+
+  message = gstd_pipeline_bus_subscription_pop (conn->subscription, &dropped);
+  if (!message) {
+    return;
+  }
+
+  req = gstd_socket_request_new (conn, NULL);
+  req->response = gstd_parser_bus_event (message, dropped);
+  g_queue_push_tail (conn->responses, req);
+  gst_message_unref (message);
+}
+
+/* Drives the connection from the reactor. Dispatches as many buffered
+ * requests as allowed to the worker pool, starts writing completed
+ * responses and reads more input when no complete request is buffered.
+ * Untagged requests are executed alone, tagged ones run concurrently up to
+ * GSTD_SOCKET_MAX_INFLIGHT per connection */
+static void
+gstd_socket_connection_pump (GstdSocketConnection * conn)
+{
+  GstdSocket *self = conn->socket;
+  GstdSocketRequest *req;
+  gboolean oneshot = !self->keep_alive && !conn->framed;
+  gchar *message;
+
+  if (conn->closing) {
+    gstd_socket_connection_release (conn);
+    return;
+  }
+
+  /* Replies produced right here, in the reactor */
+  gstd_object_set_pretty (!conn->compact);
+  gstd_object_set_binary (conn->binary);
+
+  while (!conn->subscription && !conn->broken) {
+    if (!conn->next) {
+      /* Oneshot connections serve a single command */
+      if (oneshot && conn->served) {
+        break;
+      }
+
+      message = gstd_socket_connection_next_message (conn);
+      if (!message) {
+        if (conn->broken) {
+          /* The client is told why before the connection is closed */
+          g_byte_array_set_size (conn->input, 0);
+          req = gstd_socket_request_new (conn, NULL);
+          req->response = gstd_parser_envelope (GSTD_BAD_COMMAND, NULL, NULL);
+          g_queue_push_tail (conn->responses, req);
+        }
+        break;
+      }
+
+      if (!conn->framed) {
+        g_strstrip (message);
+        if (self->keep_alive && '\0' == message[0]) {
+          g_free (message);
+          continue;
+        }
+      }
+
+      req = gstd_socket_request_new (conn, message);
+      if (!gstd_socket_request_parse_id (req)) {
+        req->response =
+            gstd_parser_envelope (GSTD_BAD_VALUE, NULL, NULL);
+        g_queue_push_tail (conn->responses, req);
+        conn->served = TRUE;
+        continue;
+      }
+      conn->next = req;
+    }
+
+    req = conn->next;
+    if (conn->barrier || conn->inflight >= GSTD_SOCKET_MAX_INFLIGHT
+        || (!req->id && conn->inflight > 0)) {
+      break;
+    }
+
+    conn->next = NULL;
+    conn->served = TRUE;
+
+    if (!req->id && gstd_socket_connection_control (conn, req)) {
+      /* The protocol may have changed */
+      oneshot = !self->keep_alive && !conn->framed;
+      continue;
+    }
+
+    conn->inflight++;
+    conn->barrier = !req->id;
+    g_thread_pool_push (self->workers, req, NULL);
+  }
+
+  if (conn->subscription) {
+    /* Whatever the client sends from now on is ignored */
+    g_byte_array_set_size (conn->input, 0);
+    if (conn->next) {
+      gstd_socket_request_free (conn->next);
+      conn->next = NULL;
+    }
+    gstd_socket_connection_stream (conn);
+  }
+
+  if (!conn->writing && !g_queue_is_empty (conn->responses)) {
+    gstd_socket_connection_write (conn, g_queue_peek_head (conn->responses));
+  }
+
+  /* Nothing more is read, the replies already owed, the error last, are
+   * written before closing */
+  if (conn->broken) {
+    if (!conn->inflight && !conn->writing) {
+      gstd_socket_connection_close (conn);
+    }
+    return;
+  }
+
+  if (conn->inflight || conn->writing || conn->next) {
+    /* Keep reading so tagged requests can be pipelined and hang ups are
+     * noticed while requests wait */
+    if (conn->next || conn->reading || conn->eof) {
+      return;
+    }
+  } else if (conn->eof || (oneshot && conn->served && !conn->subscription
+          && !conn->watches)) {
+    GST_DEBUG_OBJECT (self, "Done serving connection");
+    gstd_socket_connection_close (conn);
+    return;
+  } else if (conn->reading) {
+    return;
+  }
+
+  gstd_socket_connection_read (conn);
+}
+
+static void
+gstd_socket_read_cb (GObject * source, GAsyncResult * result, gpointer user_data)
+{
+  GstdSocketConnection *conn = user_data;
+  GError *error = NULL;
+  gssize read;
+
+  conn->reading = FALSE;
+
+  read = g_input_stream_read_finish (G_INPUT_STREAM (source), result, &error);
+  if (read < 0) {
+    /* The client is not idle while its requests are being served */
+    if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT)
+        && (conn->inflight || conn->writing)) {
+      g_error_free (error);
+      gstd_socket_connection_pump (conn);
+      return;
+    }
+
+    /* The client stopped sending without a terminator, what arrived is
+     * the oneshot command */
+    if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT)
+        && !conn->socket->keep_alive && !conn->framed && conn->partial
+        && !conn->served) {
+      GST_DEBUG_OBJECT (conn->socket, "Client paused, serving %u bytes",
+          conn->input->len);
+      g_error_free (error);
+      conn->partial = FALSE;
+      gstd_socket_connection_pump (conn);
+      return;
+    }
+
+    if (!conn->closing) {
+      GST_DEBUG_OBJECT (conn->socket, "Closing connection: %s", error->message);
+    }
+    g_error_free (error);
+    gstd_socket_connection_close (conn);
+    return;
+  }
+
+  /* A full chunk means the client likely has more to send */
+  conn->partial = sizeof (conn->chunk) == read;
+  conn->eof = 0 == read;
+
+  /* Nobody is left to wait for, responses of requests that can't be
+   * abandoned are still written in case the client only shut down its
+   * sending side */
+  if (conn->eof && conn->inflight) {
+    GST_DEBUG_OBJECT (conn->socket, "Client hung up, abandoning waits");
+    g_cancellable_cancel (conn->pending);
+  }
+
+  g_byte_array_append (conn->input, conn->chunk, read);
+  gstd_socket_connection_pump (conn);
+}
+
+/* Runs in the worker pool, the only place where commands are executed.
+ * Commands that wait, such as bus reads, are parked and complete later
+ * without holding on to the worker */
+static void
+gstd_socket_worker (gpointer data, gpointer user_data)
+{
+  GstdSocketRequest *req = data;
+  GstdSocket *self = GSTD_SOCKET (user_data);
+
+  gstd_object_set_pretty (!req->compact);
+  gstd_object_set_binary (req->binary);
+  gstd_parser_parse_cmd_async (GSTD_IPC (self)->session, req->message,
+      req->conn->pending, gstd_socket_worker_ready, req);
+}
+
+/* Wraps the result in the response envelope, from whichever thread
+ * completed the command */
+static void
+gstd_socket_worker_ready (GstdReturnCode ret, gchar * output,
+    gpointer user_data)
+{
+  GstdSocketRequest *req = user_data;
+
+  req->response = gstd_parser_envelope (ret, output, req->id);
+  g_free (output);
+
+  g_main_context_invoke (req->conn->socket->context, gstd_socket_worker_done,
+      req);
+}
+
+/* Back in the reactor, queue the response produced by the worker */
+static gboolean
+gstd_socket_worker_done (gpointer user_data)
+{
+  GstdSocketRequest *req = user_data;
+  GstdSocketConnection *conn = req->conn;
+
+  conn->inflight--;
+  if (!req->id) {
+    conn->barrier = FALSE;
+  }
+
+  if (conn->closing) {
+    gstd_socket_request_free (req);
+  } else {
+    g_queue_push_tail (conn->responses, req);
+  }
+
+  gstd_socket_connection_pump (conn);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+gstd_socket_write_header_cb (GObject * source, GAsyncResult * result,
+    gpointer user_data)
+{
+  GstdSocketRequest *req = user_data;
+  GstdSocketConnection *conn = req->conn;
+  GError *error = NULL;
+
+  if (!g_output_stream_write_all_finish (G_OUTPUT_STREAM (source), result,
+          NULL, &error)) {
+    GST_DEBUG_OBJECT (conn->socket, "Closing connection: %s", error->message);
+    g_error_free (error);
+    conn->writing = FALSE;
+    gstd_socket_connection_close (conn);
+    return;
+  }
+
+  g_output_stream_write_all_async (conn->ostream, req->response,
+      strlen (req->response), G_PRIORITY_DEFAULT, conn->cancellable,
+      gstd_socket_write_cb, req);
+}
+
+static void
+gstd_socket_write_cb (GObject * source, GAsyncResult * result, gpointer user_data)
+{
+  GstdSocketRequest *req = user_data;
+  GstdSocketConnection *conn = req->conn;
+  GError *error = NULL;
+
+  conn->writing = FALSE;
+
+  if (!g_output_stream_write_all_finish (G_OUTPUT_STREAM (source), result,
+          NULL, &error)) {
+    GST_DEBUG_OBJECT (conn->socket, "Closing connection: %s", error->message);
+    g_error_free (error);
+    gstd_socket_connection_close (conn);
+    return;
+  }
+
+  g_queue_remove (conn->responses, req);
+  gstd_socket_request_free (req);
+
+  gstd_socket_connection_pump (conn);
+}
+
+/* Closes every connection from the reactor, which quits once the last
+ * one is released */
+static gboolean
+gstd_socket_shutdown (gpointer user_data)
+{
+  GstdSocket *self = GSTD_SOCKET (user_data);
+  GList *connections;
+  GList *l;
+
+  self->stopping = TRUE;
+
+  if (!self->connections) {
+    g_main_loop_quit (self->loop);
+    return G_SOURCE_REMOVE;
+  }
+
+  /* Closing may release and unlink the connection right away */
+  connections = g_list_copy (self->connections);
+  for (l = connections; l; l = l->next) {
+    gstd_socket_connection_close (l->data);
+  }
+  g_list_free (connections);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gpointer
+gstd_socket_reactor (gpointer user_data)
+{
+  GstdSocket *self = GSTD_SOCKET (user_data);
+
+  g_main_context_push_thread_default (self->context);
+  g_main_loop_run (self->loop);
+  g_main_context_pop_thread_default (self->context);
+
+  return NULL;
+}
+
+GstdReturnCode
+gstd_socket_start (GstdIpc * base, GstdSession * session)
+{
+  GError *error = NULL;
+  GstdSocket *self = GSTD_SOCKET (base);
+  GstdSocketClass *klass = GSTD_SOCKET_GET_CLASS (self);
+  GSocketService **service;
+  guint num_workers;
+  if (!base->enabled) {
+    GST_DEBUG_OBJECT (self, "%s not enabled, skipping",
+        G_OBJECT_TYPE_NAME (self));
+    goto out;
+  }
+
+  GST_DEBUG_OBJECT (self, "Starting %s", G_OBJECT_TYPE_NAME (self));
+
+  // Close any existing connection
+  gstd_socket_stop (base);
+
+  num_workers = self->num_workers ? self->num_workers : g_get_num_processors ();
+  self->workers = g_thread_pool_new (gstd_socket_worker, self, num_workers,
+      TRUE, &error);
+  if (!self->workers)
+    goto noconnection;
+
+  /* Every socket operation is dispatched from the reactor context, the
+   * listeners must be created while it is the thread default */
+  self->context = g_main_context_new ();
+  g_main_context_push_thread_default (self->context);
+
+  service = &self->service;
+  *service = g_socket_service_new ();
+
+  if (klass->add_listeners (self, *service, &error)) {
+    /* listen to the 'incoming' signal */
+    g_signal_connect (*service, "incoming",
+        G_CALLBACK (gstd_socket_callback), self);
+
+    /* start the socket service */
+    g_socket_service_start (*service);
+  }
+
+  g_main_context_pop_thread_default (self->context);
+
+  self->loop = g_main_loop_new (self->context, FALSE);
+  self->reactor = g_thread_new ("gstd-socket", gstd_socket_reactor, self);
+
+  if (error)
+    goto noconnection;
+
+  GST_INFO_OBJECT (self, "Serving %s with %u workers",
+      G_OBJECT_TYPE_NAME (self), num_workers);
+
+out:
+  return GSTD_EOK;
+
+noconnection:
+  {
+    GST_ERROR_OBJECT (session, "%s", error->message);
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    return GSTD_NO_CONNECTION;
+  }
+}
+
+GstdReturnCode
+gstd_socket_stop (GstdIpc * base)
+{
+  GstdSocket *self = GSTD_SOCKET (base);
+  GSocketService **service;
+  GstdSession *session = base->session;
+
+  g_return_val_if_fail (session, GSTD_NULL_ARGUMENT);
+
+  GST_DEBUG_OBJECT (self, "Entering %s stop", G_OBJECT_TYPE_NAME (self));
+  if (self->service) {
+    service = &self->service;
+    GSocketListener *listener = G_SOCKET_LISTENER (*service);
+    if (*service) {
+      GST_INFO_OBJECT (session, "Closing %s connection for %s",
+          G_OBJECT_TYPE_NAME (self), GSTD_OBJECT_NAME (session));
+      g_socket_listener_close (listener);
+      g_socket_service_stop (*service);
+      g_object_unref (*service);
+      *service = NULL;
+    }
+  }
+  /* Close every connection, abandoning parked requests and letting
+   * running commands finish. Their responses are dropped */
+  if (self->reactor) {
+    g_main_context_invoke (self->context, gstd_socket_shutdown, self);
+    g_thread_join (self->reactor);
+    self->reactor = NULL;
+    g_main_loop_unref (self->loop);
+    self->loop = NULL;
+    self->stopping = FALSE;
+  }
+
+  if (self->workers) {
+    g_thread_pool_free (self->workers, FALSE, TRUE);
+    self->workers = NULL;
+  }
+
+  g_list_free_full (self->connections,
+      (GDestroyNotify) gstd_socket_connection_free);
+  self->connections = NULL;
+
+  if (self->context) {
+    g_main_context_unref (self->context);
+    self->context = NULL;
+  }
+
+  return GSTD_EOK;
+}
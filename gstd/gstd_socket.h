@@ -0,0 +1,154 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifndef __GSTD_SOCKET_H__
+#define __GSTD_SOCKET_H__
+
+#include <gio/gio.h>
+#include "gstd_return_codes.h"
+#include "gstd_session.h"
+#include "gstd_ipc.h"
+
+G_BEGIN_DECLS
+#define GSTD_SOCKET_DEFAULT_KEEP_ALIVE FALSE
+#define GSTD_SOCKET_DEFAULT_IDLE_TIMEOUT 30
+#define GSTD_SOCKET_DEFAULT_NUM_WORKERS 0
+#define GSTD_SOCKET_CHUNK_SIZE 4096
+
+/*
+ * Sending "protocol framed" on a connection switches it, after the text
+ * reply, to framed mode: every request and response is a 32 bit big
+ * endian payload length followed by the payload, with no terminator.
+ * Framed connections are persistent. Commands larger than
+ * GSTD_SOCKET_MAX_FRAME_SIZE, framed or not yet terminated text, are
+ * answered with GSTD_BAD_COMMAND and the connection is closed.
+ */
+#define GSTD_SOCKET_FRAME_HEADER_SIZE 4
+#define GSTD_SOCKET_MAX_FRAME_SIZE (64 * 1024 * 1024)
+
+/*
+ * "format compact" makes every following response on the connection
+ * leave out optional whitespace, "format pretty" goes back to indented
+ * responses, the default. Framed connections may also ask for "format
+ * cbor": responses are then CBOR maps with the same members, see
+ * #GstdCborWriter.
+ */
+
+/*
+ * Commands may be prefixed with "#<id> ", where id is a decimal number.
+ * The reply then carries the same "id" and tagged commands on a
+ * persistent connection are executed concurrently, replying as soon as
+ * they complete. Untagged commands wait for every previous one and are
+ * answered in order. Past GSTD_SOCKET_MAX_INFLIGHT commands in flight no
+ * more input is read until one completes, so clients are throttled rather
+ * than rejected.
+ */
+#define GSTD_SOCKET_MAX_INFLIGHT 64
+
+/*
+ * "bus_subscribe <pipeline> <filter>" turns the connection into a stream
+ * of the matching bus messages, each pushed as its own response with the
+ * count of messages dropped so far because the client fell behind.
+ */
+#define GSTD_SOCKET_MAX_QUEUED_MESSAGES 256
+
+/*
+ * "watch <uri> [interval=<ms>] [period=<ms>] [deadband=<delta>]" pushes
+ * the value of a property every time it changes, tagged with the URI as
+ * given, while the connection keeps serving commands. Updates are dropped
+ * once GSTD_SOCKET_MAX_QUEUED_MESSAGES responses wait for the client.
+ * "unwatch <uri>" stops them.
+ */
+#define GSTD_TYPE_SOCKET \
+  (gstd_socket_get_type())
+#define GSTD_SOCKET(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GSTD_TYPE_SOCKET,GstdSocket))
+#define GSTD_SOCKET_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GSTD_TYPE_SOCKET,GstdSocketClass))
+#define GSTD_IS_SOCKET(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GSTD_TYPE_SOCKET))
+#define GSTD_IS_SOCKET_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GSTD_TYPE_SOCKET))
+#define GSTD_SOCKET_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GSTD_TYPE_SOCKET, GstdSocketClass))
+typedef struct _GstdSocket GstdSocket;
+typedef struct _GstdSocketClass GstdSocketClass;
+
+/**
+ * A #GstdIpc serving the textual protocol over stream sockets. Sockets
+ * are polled by a single reactor thread and commands are executed by a
+ * bounded pool of workers. Subclasses only provide the listening
+ * addresses.
+ */
+struct _GstdSocket
+{
+  GstdIpc parent;
+
+  /**
+   * Serve several commands per connection
+   */
+  gboolean keep_alive;
+
+  /**
+   * Seconds a persistent connection may stay idle, 0 waits forever
+   */
+  guint idle_timeout;
+
+  /**
+   * Number of threads executing commands, 0 uses one per CPU
+   */
+  guint num_workers;
+
+  GSocketService *service;
+  GMainContext *context;
+  GMainLoop *loop;
+  GThread *reactor;
+  GThreadPool *workers;
+  GList *connections;
+  gboolean stopping;
+};
+
+struct _GstdSocketClass
+{
+  GstdIpcClass parent_class;
+
+    gboolean (*add_listeners) (GstdSocket *, GSocketService *, GError **);
+
+};
+
+GType gstd_socket_get_type (void);
+
+GstdReturnCode gstd_socket_start (GstdIpc * base, GstdSession * session);
+
+GstdReturnCode gstd_socket_stop (GstdIpc * base);
+
+/**
+ * Option callbacks shared by the subclasses' option groups. The group
+ * user data must be the #GstdSocket. Negative or out of range values
+ * are rejected.
+ */
+gboolean gstd_socket_parse_idle_timeout (const gchar * option_name,
+    const gchar * value, gpointer data, GError ** error);
+
+gboolean gstd_socket_parse_num_workers (const gchar * option_name,
+    const gchar * value, gpointer data, GError ** error);
+
+G_END_DECLS
+#endif //__GSTD_SOCKET_H__
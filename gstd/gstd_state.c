@@ -119,61 +119,71 @@ gstd_state_to_string (GstdObject * obj, gchar ** outstring)
   GValue value = G_VALUE_INIT;
   gchar *svalue;
   const gchar *typename;
+  guint fields;
 
   g_return_val_if_fail (GSTD_IS_OBJECT (obj), GSTD_NULL_ARGUMENT);
   g_return_val_if_fail (outstring, GSTD_NULL_ARGUMENT);
 
   self = GSTD_STATE(obj);
 
+  fields = gstd_object_get_fields ();
+
   /* Describe each parameter using a structure */
   gstd_iformatter_begin_object (obj->formatter);
 
-  gstd_iformatter_set_member_name (obj->formatter,"name");
-  gstd_iformatter_set_string_value (obj->formatter, GSTD_OBJECT_NAME(self));
+  if (fields & GSTD_FIELD_NAME) {
+    gstd_iformatter_set_member_name (obj->formatter,"name");
+    gstd_iformatter_set_string_value (obj->formatter, GSTD_OBJECT_NAME(self));
+  }
 
-  gstd_iformatter_set_member_name (obj->formatter,"value");
+  if (fields & GSTD_FIELD_VALUE) {
+    gstd_iformatter_set_member_name (obj->formatter,"value");
 
-  /* The state of the pipeline might have changed autonomously,
-     refresh the value */
-  self->state = gstd_state_read (self);
+    /* The state of the pipeline might have changed autonomously,
+       refresh the value */
+    self->state = gstd_state_read (self);
 
-  g_value_init (&value, GSTD_TYPE_STATE_ENUM);
-  g_value_set_enum (&value, self->state);
-  svalue = gst_value_serialize (&value);
-  gstd_iformatter_set_string_value (obj->formatter, svalue);
+    g_value_init (&value, GSTD_TYPE_STATE_ENUM);
+    g_value_set_enum (&value, self->state);
+    svalue = gst_value_serialize (&value);
+    gstd_iformatter_set_string_value (obj->formatter, svalue);
 
-  g_free (svalue);
-  g_value_unset (&value);
+    g_free (svalue);
+    g_value_unset (&value);
+  }
 
-  gstd_iformatter_set_member_name (obj->formatter, "param_spec");
-  /* Describe the parameter specs using a structure */
-  gstd_iformatter_begin_object (obj->formatter);
+  if (fields & GSTD_FIELD_PARAM_SPEC) {
+    gstd_iformatter_set_member_name (obj->formatter, "param_spec");
+    /* Describe the parameter specs using a structure */
+    gstd_iformatter_begin_object (obj->formatter);
 
-  gstd_iformatter_set_member_name (obj->formatter, "blurb");
-  gstd_iformatter_set_string_value (obj->formatter, "The state of the pipeline");
+    gstd_iformatter_set_member_name (obj->formatter, "blurb");
+    gstd_iformatter_set_string_value (obj->formatter,
+        "The state of the pipeline");
 
-  typename = g_type_name (GSTD_TYPE_STATE_ENUM);
-  gstd_iformatter_set_member_name (obj->formatter, "type");
-  gstd_iformatter_set_string_value (obj->formatter,typename);
+    typename = g_type_name (GSTD_TYPE_STATE_ENUM);
+    gstd_iformatter_set_member_name (obj->formatter, "type");
+    gstd_iformatter_set_string_value (obj->formatter,typename);
 
-  g_value_init (&value, GSTD_TYPE_PARAM_FLAGS);
-  g_value_set_flags (&value, G_PARAM_READWRITE);
-  svalue = g_strdup_value_contents(&value);
-  g_value_unset (&value);
+    g_value_init (&value, GSTD_TYPE_PARAM_FLAGS);
+    g_value_set_flags (&value, G_PARAM_READWRITE);
+    svalue = g_strdup_value_contents(&value);
+    g_value_unset (&value);
 
-  gstd_iformatter_set_member_name (obj->formatter, "access");
-  gstd_iformatter_set_string_value (obj->formatter, svalue);
+    gstd_iformatter_set_member_name (obj->formatter, "access");
+    gstd_iformatter_set_string_value (obj->formatter, svalue);
 
-  g_free (svalue);
+    g_free (svalue);
 
-  gstd_iformatter_set_member_name (obj->formatter, "construct");
-  g_value_init (&value, G_TYPE_BOOLEAN);
-  g_value_set_boolean (&value, FALSE);
-  gstd_iformatter_set_value (obj->formatter, &value);
-  g_value_unset (&value);
+    gstd_iformatter_set_member_name (obj->formatter, "construct");
+    g_value_init (&value, G_TYPE_BOOLEAN);
+    g_value_set_boolean (&value, FALSE);
+    gstd_iformatter_set_value (obj->formatter, &value);
+    g_value_unset (&value);
 
-  /* Close parameter specs structure */
-  gstd_iformatter_end_object (obj->formatter);
+    /* Close parameter specs structure */
+    gstd_iformatter_end_object (obj->formatter);
+  }
 
   /* Close parameter structure */
   gstd_iformatter_end_object (obj->formatter);
@@ -23,6 +23,7 @@
 #include "gstd_return_codes.h"
 #include "gstd_session.h"
 #include "gstd_ipc.h"
+#include "gstd_socket.h"
 
 G_BEGIN_DECLS
 #define GSTD_TCP_DEFAULT_PORT 5000
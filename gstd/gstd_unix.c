@@ -0,0 +1,261 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/stat.h>
+#include <gst/gst.h>
+#include <glib/gstdio.h>
+#include <gio/gunixsocketaddress.h>
+
+#include "gstd_unix.h"
+
+/* Gstd Unix debugging category */
+GST_DEBUG_CATEGORY_STATIC (gstd_unix_debug);
+#define GST_CAT_DEFAULT gstd_unix_debug
+
+#define GSTD_DEBUG_DEFAULT_LEVEL GST_LEVEL_INFO
+
+/* The option parser may replace path, fall back to the default here so
+ * it never has to be freed behind its back */
+#define GSTD_UNIX_PATH(self) \
+    ((self)->path ? (self)->path : GSTD_UNIX_DEFAULT_PATH)
+
+struct _GstdUnix
+{
+  GstdSocket parent;
+  gchar *path;
+};
+
+struct _GstdUnixClass
+{
+  GstdSocketClass parent_class;
+};
+
+
+G_DEFINE_TYPE (GstdUnix, gstd_unix, GSTD_TYPE_SOCKET);
+
+enum
+{
+  PROP_PATH = 1,
+  N_PROPERTIES                  // NOT A PROPERTY
+};
+
+
+/* VTable */
+
+static gboolean gstd_unix_add_listeners (GstdSocket * base,
+    GSocketService * service, GError ** error);
+static void gstd_unix_remove_socket_file (GstdUnix * self);
+static void gstd_unix_set_property (GObject *, guint, const GValue *,
+    GParamSpec *);
+static void gstd_unix_get_property (GObject *, guint, GValue *, GParamSpec *);
+static void gstd_unix_dispose (GObject *);
+gboolean gstd_unix_init_get_option_group (GstdIpc * base,
+    GOptionGroup ** group);
+
+static void
+gstd_unix_class_init (GstdUnixClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GstdIpcClass *gstdipc_class = GSTD_IPC_CLASS (klass);
+  GstdSocketClass *socket_class = GSTD_SOCKET_CLASS (klass);
+  GParamSpec *properties[N_PROPERTIES] = { NULL, };
+  guint debug_color;
+  object_class->set_property = gstd_unix_set_property;
+  object_class->get_property = gstd_unix_get_property;
+  object_class->dispose = gstd_unix_dispose;
+  gstdipc_class->start = GST_DEBUG_FUNCPTR (gstd_unix_start);
+  gstdipc_class->stop = GST_DEBUG_FUNCPTR (gstd_unix_stop);
+  gstdipc_class->get_option_group =
+      GST_DEBUG_FUNCPTR (gstd_unix_init_get_option_group);
+  socket_class->add_listeners = GST_DEBUG_FUNCPTR (gstd_unix_add_listeners);
+
+  properties[PROP_PATH] =
+      g_param_spec_string ("path",
+      "Path",
+      "The file system path of the unix socket to listen to",
+      GSTD_UNIX_DEFAULT_PATH,
+      G_PARAM_READWRITE |
+      G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS | GSTD_PARAM_READ);
+
+  g_object_class_install_properties (object_class, N_PROPERTIES, properties);
+
+  /* Initialize debug category with nice colors */
+  debug_color = GST_DEBUG_FG_BLACK | GST_DEBUG_BOLD | GST_DEBUG_BG_WHITE;
+  GST_DEBUG_CATEGORY_INIT (gstd_unix_debug, "gstdunix", debug_color,
+      "Gstd Unix category");
+}
+
+static void
+gstd_unix_init (GstdUnix * self)
+{
+  GST_INFO_OBJECT (self, "Initializing gstd Unix");
+  GstdIpc *base = GSTD_IPC (self);
+  self->path = NULL;
+  base->enabled = FALSE;
+}
+
+static void
+gstd_unix_get_property (GObject * object,
+    guint property_id, GValue * value, GParamSpec * pspec)
+{
+  GstdUnix *self = GSTD_UNIX (object);
+
+  switch (property_id) {
+    case PROP_PATH:
+      GST_DEBUG_OBJECT (self, "Returning path %s", GSTD_UNIX_PATH (self));
+      g_value_set_string (value, GSTD_UNIX_PATH (self));
+      break;
+
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_unix_set_property (GObject * object,
+    guint property_id, const GValue * value, GParamSpec * pspec)
+{
+  GstdUnix *self = GSTD_UNIX (object);
+
+  switch (property_id) {
+    case PROP_PATH:
+      g_free (self->path);
+      self->path = g_value_dup_string (value);
+      GST_DEBUG_OBJECT (self, "Path changed to %s", GSTD_UNIX_PATH (self));
+      break;
+
+    default:
+      /* We don't have any other property... */
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+      break;
+  }
+}
+
+static void
+gstd_unix_dispose (GObject * object)
+{
+  GstdUnix *self = GSTD_UNIX (object);
+
+  GST_INFO_OBJECT (object, "Deinitializing gstd Unix");
+
+  g_free (self->path);
+  self->path = NULL;
+
+  G_OBJECT_CLASS (gstd_unix_parent_class)->dispose (object);
+}
+
+/* Only remove what looks like a socket left behind by a previous run,
+ * never a regular file the user pointed us to by mistake */
+static void
+gstd_unix_remove_socket_file (GstdUnix * self)
+{
+  GStatBuf buf;
+
+  if (0 == g_lstat (GSTD_UNIX_PATH (self), &buf) && S_ISSOCK (buf.st_mode)) {
+    g_unlink (GSTD_UNIX_PATH (self));
+  }
+}
+
+static gboolean
+gstd_unix_add_listeners (GstdSocket * base, GSocketService * service,
+    GError ** error)
+{
+  GstdUnix *self = GSTD_UNIX (base);
+  GSocketAddress *address;
+  gboolean ret;
+
+  gstd_unix_remove_socket_file (self);
+
+  address = g_unix_socket_address_new (GSTD_UNIX_PATH (self));
+  ret = g_socket_listener_add_address (G_SOCKET_LISTENER (service), address,
+      G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_DEFAULT, NULL, NULL, error);
+  g_object_unref (address);
+
+  return ret;
+}
+
+GstdReturnCode
+gstd_unix_start (GstdIpc * base, GstdSession * session)
+{
+  GST_DEBUG_OBJECT (base, "Starting Unix");
+
+  return gstd_socket_start (base, session);
+}
+
+GstdReturnCode
+gstd_unix_stop (GstdIpc * base)
+{
+  GstdUnix *self = GSTD_UNIX (base);
+  GstdReturnCode ret;
+
+  GST_DEBUG_OBJECT (base, "Entering Unix stop ");
+
+  ret = gstd_socket_stop (base);
+  if (base->enabled) {
+    gstd_unix_remove_socket_file (self);
+  }
+
+  return ret;
+}
+
+gboolean
+gstd_unix_init_get_option_group (GstdIpc * base, GOptionGroup ** group)
+{
+  GstdUnix *self = GSTD_UNIX (base);
+  GstdSocket *socket = GSTD_SOCKET (base);
+  GST_DEBUG_OBJECT (self, "Unix init group callback ");
+  GOptionEntry unix_args[] = {
+    {"enable-unix-protocol", 'u', 0, G_OPTION_ARG_NONE, &base->enabled,
+        "Enable attach the server through a unix socket", NULL}
+    ,
+    {"unix-path", 'f', 0, G_OPTION_ARG_FILENAME, &self->path,
+          "Path of the unix socket (default " GSTD_UNIX_DEFAULT_PATH ")",
+        "unix-path"}
+    ,
+    {"unix-keep-alive", 0, 0, G_OPTION_ARG_NONE, &socket->keep_alive,
+          "Serve multiple NUL or newline terminated commands per connection",
+        NULL}
+    ,
+    {"unix-idle-timeout", 0, 0, G_OPTION_ARG_CALLBACK,
+        (gpointer) gstd_socket_parse_idle_timeout,
+          "Seconds before an idle connection is closed, "
+          "0 waits forever (default 30)",
+        "unix-idle-timeout"}
+    ,
+    {"unix-num-workers", 0, 0, G_OPTION_ARG_CALLBACK,
+        (gpointer) gstd_socket_parse_num_workers,
+          "Number of threads executing commands, 0 uses one per CPU "
+          "(default 0)",
+        "unix-num-workers"}
+    ,
+    {NULL}
+  };
+  *group = g_option_group_new ("gstd-unix", ("Unix Socket Options"),
+      ("Show Unix Socket Options"), socket, NULL);
+
+  g_option_group_add_entries (*group, unix_args);
+  return TRUE;
+}
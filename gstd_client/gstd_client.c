@@ -108,8 +108,9 @@ static GstdClientCmd cmds[] = {
   {"help", gstd_client_cmd_help, "Prints help information", "help [command]"},
   {"create", gstd_client_cmd_tcp, "Creates a resource at the given URI",
         "create <URI> [property value ...]"},
-  {"read", gstd_client_cmd_tcp, "Reads the resource at the given URI",
-        "read <URI>"},
+  {"read", gstd_client_cmd_tcp, "Reads the resource at the given URI. "
+        "Describes properties only with the given fields, out of name, value "
+        "and param_spec", "read <URI> [fields=<field>[,<field>...]]"},
   {"update", gstd_client_cmd_tcp, "Updates the resource at the given URI",
         "update <URI> [property value ...]"},
   {"delete", gstd_client_cmd_tcp,
@@ -132,22 +133,47 @@ static GstdClientCmd cmds[] = {
       "pipeline_pause <name>"},
   {"pipeline_stop", gstd_client_cmd_tcp, "Sets the pipeline to null",
       "pipeline_stop <name>"},
+  {"pipeline_snapshot", gstd_client_cmd_tcp,
+        "Queries the properties of every element of the pipeline at once, "
+        "or only the ones listed",
+      "pipeline_snapshot <name> [properties=<property>[,<property>...]]"},
 
   {"element_set", gstd_client_cmd_tcp,
         "Sets a property in an element of a given pipeline",
       "element_set <pipe> <element> <property> <value>"},
   {"element_get", gstd_client_cmd_tcp,
-        "Queries a property in an element of a given pipeline",
-      "element_set <pipe> <element> <property>"},
-
-  {"list_pipelines", gstd_client_cmd_tcp, "List the existing pipelines",
-      "list_pipelines"},
+        "Queries a property in an element of a given pipeline, takes the "
+        "same options as read",
+      "element_get <pipe> <element> <property> [fields=<field>[,...]]"},
+  {"element_set_many", gstd_client_cmd_tcp,
+        "Sets several properties in an element of a given pipeline at once. "
+        "Values may be quoted",
+      "element_set_many <pipe> <element> <property>=<value> ..."},
+  {"element_get_many", gstd_client_cmd_tcp,
+        "Queries several properties in an element of a given pipeline",
+      "element_get_many <pipe> <element> <property> ..."},
+  {"element_ramp", gstd_client_cmd_tcp,
+        "Moves a controllable numeric property of an element to the target "
+        "value over the given nanoseconds, sampled by the element itself. "
+        "Curves are none, linear (default), cubic or cubic-monotonic",
+      "element_ramp <pipe> <element> <property> <target> <duration> [curve]"},
+
+  {"list_pipelines", gstd_client_cmd_tcp,
+        "List the existing pipelines. Pages through them with the optional "
+        "offset=<n>, limit=<n> and prefix=<name> options, fields=<field> "
+        "works as for read",
+      "list_pipelines [offset=<n>] [limit=<n>] [prefix=<name>] "
+      "[fields=<field>[,...]]"},
   {"list_elements", gstd_client_cmd_tcp,
-        "List the elements in a given pipeline",
-      "list_elements <pipe>"},
+        "List the elements in a given pipeline, takes the same options as "
+        "list_pipelines",
+      "list_elements <pipe> [offset=<n>] [limit=<n>] [prefix=<name>] "
+      "[fields=<field>[,...]]"},
   {"list_properties", gstd_client_cmd_tcp,
-        "List the properties of an element in a given pipeline",
-      "list_properties <pipe> <elemement>"},
+        "List the properties of an element in a given pipeline, takes the "
+        "same options as list_pipelines",
+      "list_properties <pipe> <elemement> [offset=<n>] [limit=<n>] "
+      "[prefix=<name>] [fields=<field>[,...]]"},
 
   {"bus_read", gstd_client_cmd_tcp, "List the existing pipelines",
       "bus_read <pipe>"},
@@ -182,6 +208,12 @@ static GstdClientCmd cmds[] = {
       "Enable/Disable colors in the debug logging",
       "debug_color <colors>"},
 
+  {"batch", gstd_client_cmd_tcp,
+      "Run a list of commands in a single request. Atomic batches stop at "
+      "the first failure and restore the properties they changed. Also "
+      "available as create /batch [atomic] [...]",
+      "batch [atomic] [\"<command>\", \"<command>\", ...]"},
+
   {NULL}
 };
 
@@ -511,8 +543,9 @@ gstd_client_cmd_tcp (gchar * name, gchar * arg, GstdClientData * data)
   GError *err = NULL;
   GInputStream *istream;
   GOutputStream *ostream;
-  gchar buffer[1024 * 1024];
-  gint read;
+  gchar buffer[4096];
+  GString *response;
+  gssize read;
 
   g_return_val_if_fail (name, -1);
   g_return_val_if_fail (arg, -1);
@@ -530,7 +563,9 @@ gstd_client_cmd_tcp (gchar * name, gchar * arg, GstdClientData * data)
   ostream = g_io_stream_get_output_stream (G_IO_STREAM (data->con));
 
   err = NULL;
-  g_output_stream_write (ostream, cmd, strlen (cmd), NULL, &err);
+  /* Send the NUL terminator as well, so keep-alive servers know where
+   * the command ends */
+  g_output_stream_write (ostream, cmd, strlen (cmd) + 1, NULL, &err);
   g_free (cmd);
   if (err)
     goto error;
@@ -538,13 +573,21 @@ gstd_client_cmd_tcp (gchar * name, gchar * arg, GstdClientData * data)
   //Paranoia flush
   g_output_stream_flush (ostream, NULL, NULL);
 
-  read = g_input_stream_read (istream, &buffer, sizeof (buffer), NULL, &err);
-  if (err)
-    goto error;
+  /* Responses may be larger than a single read, collect them until the
+   * NUL terminator or until the server closes the connection */
+  response = g_string_new (NULL);
+  do {
+    read = g_input_stream_read (istream, buffer, sizeof (buffer), NULL, &err);
+    if (err) {
+      g_string_free (response, TRUE);
+      goto error;
+    }
+    g_string_append_len (response, buffer, read);
+  } while (read > 0 && '\0' != buffer[read - 1]);
 
-  //Make sure it has its sentinel and print
-  buffer[read] = '\0';
-  g_print ("%s\n", buffer);
+  //The GString already has its sentinel
+  g_print ("%s\n", response->str);
+  g_string_free (response, TRUE);
 
   // FIXME: Hack to open a new connection with every message
   g_object_unref (data->con);
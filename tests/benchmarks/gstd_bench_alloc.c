@@ -0,0 +1,177 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+/*
+ * Counts heap allocations and measures the time spent per command by
+ * the command parser, without any IPC involved. Each high level command
+ * is compared against the equivalent low level command addressing the
+ * same node through its URI.
+ *
+ *   gstd_bench_alloc -n 100000
+ *
+ * Allocations are counted by interposing malloc, calloc and realloc,
+ * which requires glibc.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <gst/gst.h>
+
+#include "gstd_session.h"
+#include "gstd_parser.h"
+
+#define GSTD_BENCH_DEFAULT_ITERATIONS 10000
+
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t nmemb, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+
+static volatile gint counting = 0;
+static volatile gint allocations = 0;
+
+void *
+malloc (size_t size)
+{
+  if (counting)
+    g_atomic_int_inc (&allocations);
+  return __libc_malloc (size);
+}
+
+void *
+calloc (size_t nmemb, size_t size)
+{
+  if (counting)
+    g_atomic_int_inc (&allocations);
+  return __libc_calloc (nmemb, size);
+}
+
+void *
+realloc (void *ptr, size_t size)
+{
+  if (counting)
+    g_atomic_int_inc (&allocations);
+  return __libc_realloc (ptr, size);
+}
+
+typedef struct _GstdBenchCase
+{
+  const gchar *name;
+  const gchar *cmd;
+} GstdBenchCase;
+
+static GstdBenchCase cases[] = {
+  {"element_set", "element_set p0 src num-buffers 10"},
+  {"update uri",
+      "update /pipelines/p0/elements/src/properties/num-buffers 10"},
+  {"element_get", "element_get p0 src num-buffers"},
+  {"read uri", "read /pipelines/p0/elements/src/properties/num-buffers"},
+  {"pipeline_pause", "pipeline_pause p0"},
+  {"update uri", "update /pipelines/p0/state paused"},
+  {NULL}
+};
+
+static gboolean
+gstd_bench_run (GstdSession * session, const gchar * cmd)
+{
+  gchar *response = NULL;
+  GstdReturnCode ret;
+
+  ret = gstd_parser_parse_cmd (session, cmd, &response);
+  g_free (response);
+
+  return GSTD_EOK == ret;
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  GstdSession *session;
+  GstdBenchCase *bc;
+  GError *error = NULL;
+  GOptionContext *context;
+  gint64 start, elapsed;
+  guint iterations = GSTD_BENCH_DEFAULT_ITERATIONS;
+  guint i;
+  gint ret = EXIT_SUCCESS;
+
+  GOptionEntry entries[] = {
+    {"iterations", 'n', 0, G_OPTION_ARG_INT, &iterations,
+        "Number of times each command is run (default 10000)", "iterations"}
+    ,
+    {NULL}
+  };
+
+  /* Route GObject instances through malloc so they get counted too */
+  g_setenv ("G_SLICE", "always-malloc", TRUE);
+
+  context = g_option_context_new ("- gstd command parser allocations");
+  g_option_context_add_main_entries (context, entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    return EXIT_FAILURE;
+  }
+  g_option_context_free (context);
+
+  if (0 == iterations)
+    iterations = 1;
+
+  gst_init (&argc, &argv);
+
+  session = gstd_session_new ("Bench Session");
+
+  if (!gstd_bench_run (session,
+          "pipeline_create p0 fakesrc name=src ! fakesink")) {
+    g_printerr ("Unable to create the benchmark pipeline\n");
+    g_object_unref (session);
+    return EXIT_FAILURE;
+  }
+
+  g_print ("%-16s %12s %12s\n", "command", "allocs/op", "ns/op");
+
+  for (bc = cases; bc->name; bc++) {
+    /* Warm up type registrations and caches */
+    if (!gstd_bench_run (session, bc->cmd)) {
+      g_printerr ("\"%s\" failed\n", bc->cmd);
+      ret = EXIT_FAILURE;
+      continue;
+    }
+
+    g_atomic_int_set (&allocations, 0);
+    g_atomic_int_set (&counting, 1);
+    start = g_get_monotonic_time ();
+    for (i = 0; i < iterations; i++) {
+      gstd_bench_run (session, bc->cmd);
+    }
+    elapsed = g_get_monotonic_time () - start;
+    g_atomic_int_set (&counting, 0);
+
+    g_print ("%-16s %12.1f %12.1f\n", bc->name,
+        g_atomic_int_get (&allocations) / (gdouble) iterations,
+        elapsed * 1000.0 / iterations);
+  }
+
+  gstd_bench_run (session, "pipeline_delete p0");
+  g_object_unref (session);
+
+  return ret;
+}
@@ -0,0 +1,145 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+/*
+ * Measures reads of an element with many properties with and without
+ * field projection, without any IPC involved.
+ *
+ *   gstd_bench_fields -n 1000 -e "videotestsrc name=el ! fakesink"
+ *
+ * The description must name the measured element "el".
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_session.h"
+#include "gstd_parser.h"
+
+#define GSTD_BENCH_DEFAULT_ITERATIONS 1000
+#define GSTD_BENCH_DEFAULT_DESCRIPTION "videotestsrc name=el ! fakesink"
+
+static const gchar *commands[] = {
+  "list_properties bench el",
+  "list_properties bench el fields=name",
+  "read /pipelines/bench/elements/el",
+  "read /pipelines/bench/elements/el fields=value",
+  "element_get bench el name",
+  "element_get bench el name fields=value",
+  NULL
+};
+
+static gboolean
+gstd_bench_command (GstdSession * session, const gchar * cmd,
+    guint iterations)
+{
+  gchar *response;
+  gint64 start, elapsed;
+  gsize bytes = 0;
+  guint i;
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < iterations; i++) {
+    response = NULL;
+    if (gstd_parser_parse_cmd (session, cmd, &response)) {
+      g_free (response);
+      return FALSE;
+    }
+    bytes += strlen (response);
+    g_free (response);
+  }
+  elapsed = g_get_monotonic_time () - start;
+
+  g_print ("%-50s %12.1f %12" G_GSIZE_FORMAT "\n", cmd,
+      elapsed * 1000.0 / iterations, bytes / iterations);
+
+  return TRUE;
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  GstdSession *session;
+  GError *error = NULL;
+  GOptionContext *context;
+  gchar *response = NULL;
+  gchar *cmd;
+  gchar *description = NULL;
+  guint iterations = GSTD_BENCH_DEFAULT_ITERATIONS;
+  gint ret = EXIT_SUCCESS;
+  guint i;
+
+  GOptionEntry entries[] = {
+    {"iterations", 'n', 0, G_OPTION_ARG_INT, &iterations,
+        "Number of times each command is run (default 1000)", "iterations"}
+    ,
+    {"element", 'e', 0, G_OPTION_ARG_STRING, &description,
+          "Pipeline holding the measured element, named \"el\" (default "
+          "\"" GSTD_BENCH_DEFAULT_DESCRIPTION "\")", "description"}
+    ,
+    {NULL}
+  };
+
+  context = g_option_context_new ("- gstd field projection cost");
+  g_option_context_add_main_entries (context, entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    return EXIT_FAILURE;
+  }
+  g_option_context_free (context);
+
+  if (0 == iterations)
+    iterations = 1;
+
+  gst_init (&argc, &argv);
+
+  session = gstd_session_new ("Bench Session");
+
+  cmd = g_strdup_printf ("pipeline_create bench %s",
+      description ? description : GSTD_BENCH_DEFAULT_DESCRIPTION);
+  if (gstd_parser_parse_cmd (session, cmd, &response)) {
+    g_printerr ("Unable to create the benchmark pipeline\n");
+    ret = EXIT_FAILURE;
+    goto out;
+  }
+
+  g_print ("%-50s %12s %12s\n", "command", "ns/op", "bytes/op");
+
+  for (i = 0; commands[i]; i++) {
+    if (!gstd_bench_command (session, commands[i], iterations)) {
+      g_printerr ("\"%s\" failed\n", commands[i]);
+      ret = EXIT_FAILURE;
+      break;
+    }
+  }
+
+out:
+  g_free (response);
+  g_free (cmd);
+  g_free (description);
+  g_object_unref (session);
+
+  return ret;
+}
@@ -0,0 +1,149 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+/*
+ * Measures serialization throughput of each formatter, without any IPC
+ * involved, for an element and for a bus message.
+ *
+ *   gstd_bench_format -n 10000
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_session.h"
+#include "gstd_parser.h"
+#include "gstd_bus_msg.h"
+#include "gstd_json_builder.h"
+#include "gstd_json_writer.h"
+#include "gstd_cbor_writer.h"
+
+#define GSTD_BENCH_DEFAULT_ITERATIONS 10000
+
+typedef struct _GstdBenchFormatter
+{
+  const gchar *name;
+  GType (*get_type) (void);
+} GstdBenchFormatter;
+
+static GstdBenchFormatter formatters[] = {
+  {"builder", gstd_json_builder_get_type},
+  {"writer", gstd_json_writer_get_type},
+  {"cbor", gstd_cbor_writer_get_type},
+  {NULL}
+};
+
+static void
+gstd_bench_format (const gchar * formatter, const gchar * name,
+    GstdObject * object, guint iterations)
+{
+  gchar *out;
+  gint64 start, elapsed;
+  gsize bytes = 0;
+  guint i;
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < iterations; i++) {
+    out = NULL;
+    gstd_object_to_string (object, &out);
+    bytes += gstd_object_get_binary ()? gstd_cbor_writer_get_size (out) :
+        strlen (out);
+    g_free (out);
+  }
+  elapsed = g_get_monotonic_time () - start;
+
+  g_print ("%-10s %-10s %12.1f %12.1f %12" G_GSIZE_FORMAT "\n", formatter,
+      name, elapsed * 1000.0 / iterations, bytes / (gdouble) MAX (elapsed, 1),
+      bytes / iterations);
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  GstdSession *session;
+  GstdObject *element = NULL;
+  GstdObject *message;
+  GstdBenchFormatter *bf;
+  GError *error = NULL;
+  GOptionContext *context;
+  gchar *response = NULL;
+  guint iterations = GSTD_BENCH_DEFAULT_ITERATIONS;
+
+  GOptionEntry entries[] = {
+    {"iterations", 'n', 0, G_OPTION_ARG_INT, &iterations,
+        "Number of times each object is serialized (default 10000)",
+          "iterations"}
+    ,
+    {NULL}
+  };
+
+  context = g_option_context_new ("- gstd formatter throughput");
+  g_option_context_add_main_entries (context, entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    return EXIT_FAILURE;
+  }
+  g_option_context_free (context);
+
+  if (0 == iterations)
+    iterations = 1;
+
+  gst_init (&argc, &argv);
+
+  session = gstd_session_new ("Bench Session");
+
+  gstd_parser_parse_cmd (session,
+      "pipeline_create p0 videotestsrc name=src ! fakesink", &response);
+  g_free (response);
+  if (gstd_get_by_uri (session, "/pipelines/p0/elements/src", &element)) {
+    g_printerr ("Unable to create the benchmark pipeline\n");
+    g_object_unref (session);
+    return EXIT_FAILURE;
+  }
+
+  error = g_error_new_literal (GST_CORE_ERROR, GST_CORE_ERROR_FAILED,
+      "Internal data stream error, \"streaming stopped\"\n");
+  message = GSTD_OBJECT (gstd_bus_msg_factory_make (gst_message_new_error
+          (NULL, error, "gstbasesrc.c(2950): gst_base_src_loop ():\n"
+              "streaming stopped, reason not-negotiated (-4)")));
+  g_error_free (error);
+
+  g_print ("%-10s %-10s %12s %12s %12s\n", "formatter", "object", "ns/op",
+      "MB/s", "bytes/op");
+
+  for (bf = formatters; bf->name; bf++) {
+    /* The binary formatter is chosen per thread, like for a connection */
+    gstd_object_set_binary (GSTD_TYPE_CBOR_WRITER == bf->get_type ());
+    gstd_object_set_formatter_type (bf->get_type ());
+    gstd_bench_format (bf->name, "element", element, iterations);
+    gstd_bench_format (bf->name, "bus_msg", message, iterations);
+  }
+
+  g_object_unref (message);
+  g_object_unref (element);
+  g_object_unref (session);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,181 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+/*
+ * Measures the time and resident memory taken by pipeline_create as
+ * pipelines accumulate, without any IPC involved.
+ *
+ *   gstd_bench_pipeline -p 500 -e 20
+ *
+ * Creates the given number of "fakesrc ! identity ! ... ! fakesink"
+ * pipelines with the given number of elements each. Resident memory is
+ * read from /proc/self/statm, which requires Linux.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <gst/gst.h>
+
+#include "gstd_session.h"
+#include "gstd_parser.h"
+
+#define GSTD_BENCH_DEFAULT_PIPELINES 200
+#define GSTD_BENCH_DEFAULT_ELEMENTS 20
+
+static gboolean
+gstd_bench_run (GstdSession * session, const gchar * cmd)
+{
+  gchar *response = NULL;
+  GstdReturnCode ret;
+
+  ret = gstd_parser_parse_cmd (session, cmd, &response);
+  g_free (response);
+
+  return GSTD_EOK == ret;
+}
+
+static gsize
+gstd_bench_rss (void)
+{
+  gchar *contents = NULL;
+  gchar **fields;
+  gsize rss = 0;
+
+  if (!g_file_get_contents ("/proc/self/statm", &contents, NULL, NULL))
+    return 0;
+
+  fields = g_strsplit (contents, " ", 3);
+  if (fields[0] && fields[1])
+    rss = g_ascii_strtoull (fields[1], NULL, 10) * sysconf (_SC_PAGESIZE);
+
+  g_strfreev (fields);
+  g_free (contents);
+
+  return rss;
+}
+
+static gchar *
+gstd_bench_description (guint elements)
+{
+  GString *desc;
+  guint i;
+
+  desc = g_string_new ("fakesrc");
+  for (i = 2; i < elements; i++) {
+    g_string_append (desc, " ! identity");
+  }
+  g_string_append (desc, " ! fakesink");
+
+  return g_string_free (desc, FALSE);
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  GstdSession *session;
+  GError *error = NULL;
+  GOptionContext *context;
+  gchar *desc;
+  gchar *cmd;
+  gint64 start, elapsed = 0;
+  gsize rss_start, rss_end;
+  guint pipelines = GSTD_BENCH_DEFAULT_PIPELINES;
+  guint elements = GSTD_BENCH_DEFAULT_ELEMENTS;
+  guint created = 0;
+  guint i;
+  gint ret = EXIT_SUCCESS;
+
+  GOptionEntry entries[] = {
+    {"pipelines", 'p', 0, G_OPTION_ARG_INT, &pipelines,
+        "Number of pipelines created (default 200)", "pipelines"}
+    ,
+    {"elements", 'e', 0, G_OPTION_ARG_INT, &elements,
+        "Number of elements per pipeline (default 20)", "elements"}
+    ,
+    {NULL}
+  };
+
+  context = g_option_context_new ("- gstd pipeline creation cost");
+  g_option_context_add_main_entries (context, entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    return EXIT_FAILURE;
+  }
+  g_option_context_free (context);
+
+  if (0 == pipelines)
+    pipelines = 1;
+  if (elements < 2)
+    elements = 2;
+
+  gst_init (&argc, &argv);
+
+  session = gstd_session_new ("Bench Session");
+  desc = gstd_bench_description (elements);
+
+  /* Warm up type registrations and plugin loading */
+  cmd = g_strdup_printf ("pipeline_create warmup %s", desc);
+  if (!gstd_bench_run (session, cmd)
+      || !gstd_bench_run (session, "pipeline_delete warmup")) {
+    g_printerr ("Unable to create the benchmark pipeline\n");
+    ret = EXIT_FAILURE;
+  }
+  g_free (cmd);
+
+  rss_start = gstd_bench_rss ();
+
+  for (i = 0; EXIT_SUCCESS == ret && i < pipelines; i++) {
+    cmd = g_strdup_printf ("pipeline_create p%u %s", i, desc);
+    start = g_get_monotonic_time ();
+    if (gstd_bench_run (session, cmd)) {
+      created++;
+    } else {
+      g_printerr ("\"pipeline_create p%u\" failed\n", i);
+      ret = EXIT_FAILURE;
+    }
+    elapsed += g_get_monotonic_time () - start;
+    g_free (cmd);
+  }
+
+  rss_end = gstd_bench_rss ();
+
+  if (created) {
+    g_print ("%-12s %12s %12s %12s\n", "pipelines", "elements",
+        "us/create", "KiB/pipeline");
+    g_print ("%-12u %12u %12.1f %12.1f\n", created, elements,
+        elapsed / (gdouble) created,
+        (rss_end - rss_start) / 1024.0 / created);
+  }
+
+  for (i = 0; i < created; i++) {
+    cmd = g_strdup_printf ("pipeline_delete p%u", i);
+    gstd_bench_run (session, cmd);
+    g_free (cmd);
+  }
+
+  g_free (desc);
+  g_object_unref (session);
+
+  return ret;
+}
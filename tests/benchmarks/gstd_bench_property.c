@@ -0,0 +1,213 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+/*
+ * Measures the set and get latency of properties of every type, through
+ * their typed node and through the generic one that serializes values,
+ * without any IPC involved.
+ *
+ *   gstd_bench_property -n 100000 -e "playbin name=el" -p flags=video+audio
+ *
+ * The description must name the measured element "el". Every -p gives a
+ * property along with the value it is set to.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <gst/gst.h>
+
+#include "gstd_session.h"
+#include "gstd_parser.h"
+#include "gstd_property.h"
+
+#define GSTD_BENCH_DEFAULT_ITERATIONS 100000
+#define GSTD_BENCH_DEFAULT_DESCRIPTION "filesrc name=el ! fakesink"
+
+static const gchar *default_properties[] = {
+  "num-buffers=100",
+  "blocksize=4096",
+  "do-timestamp=true",
+  "format=time",
+  "location=/dev/null",
+  NULL
+};
+
+/* Returns the nanoseconds taken by a set and a get of value through node */
+static gboolean
+gstd_bench_node (GstdObject * node, const gchar * value, guint iterations,
+    gdouble * set, gdouble * get)
+{
+  gchar *response;
+  gint64 start;
+  guint i;
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < iterations; i++) {
+    if (gstd_object_update (node, value)) {
+      return FALSE;
+    }
+  }
+  *set = (g_get_monotonic_time () - start) * 1000.0 / iterations;
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < iterations; i++) {
+    response = NULL;
+    if (gstd_object_to_string (node, &response)) {
+      g_free (response);
+      return FALSE;
+    }
+    g_free (response);
+  }
+  *get = (g_get_monotonic_time () - start) * 1000.0 / iterations;
+
+  return TRUE;
+}
+
+static gboolean
+gstd_bench_property (GObject * element, const gchar * property,
+    guint iterations)
+{
+  GstdObject *typed, *generic;
+  GParamSpec *pspec;
+  gchar **pair;
+  gdouble typed_set, typed_get, generic_set, generic_get;
+  gboolean ret = FALSE;
+
+  pair = g_strsplit (property, "=", 2);
+  if (!pair[0] || !pair[1]) {
+    goto out;
+  }
+
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (element), pair[0]);
+  if (!pspec) {
+    goto out;
+  }
+
+  typed = g_object_new (gstd_property_node_type (pspec), "name", pspec->name,
+      "target", element, NULL);
+  generic = g_object_new (GSTD_TYPE_PROPERTY, "name", pspec->name, "target",
+      element, NULL);
+
+  ret = gstd_bench_node (typed, pair[1], iterations, &typed_set, &typed_get)
+      && gstd_bench_node (generic, pair[1], iterations, &generic_set,
+      &generic_get);
+
+  if (ret) {
+    g_print ("%-20s %-20s %10.1f %10.1f %10.1f %10.1f\n", pspec->name,
+        G_OBJECT_TYPE_NAME (typed), typed_set, generic_set, typed_get,
+        generic_get);
+  }
+
+  g_object_unref (typed);
+  g_object_unref (generic);
+
+out:
+  g_strfreev (pair);
+
+  return ret;
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  GstdSession *session;
+  GstdObject *node = NULL;
+  GObject *element = NULL;
+  GError *error = NULL;
+  GOptionContext *context;
+  gchar *response = NULL;
+  gchar *cmd;
+  gchar *description = NULL;
+  gchar **properties = NULL;
+  const gchar *const *property;
+  guint iterations = GSTD_BENCH_DEFAULT_ITERATIONS;
+  gint ret = EXIT_SUCCESS;
+
+  GOptionEntry entries[] = {
+    {"iterations", 'n', 0, G_OPTION_ARG_INT, &iterations,
+        "Number of sets and gets of each property (default 100000)",
+        "iterations"}
+    ,
+    {"element", 'e', 0, G_OPTION_ARG_STRING, &description,
+          "Pipeline holding the measured element, named \"el\" (default "
+          "\"" GSTD_BENCH_DEFAULT_DESCRIPTION "\")", "description"}
+    ,
+    {"property", 'p', 0, G_OPTION_ARG_STRING_ARRAY, &properties,
+        "Property to measure and the value to set, may be repeated",
+        "name=value"}
+    ,
+    {NULL}
+  };
+
+  context = g_option_context_new ("- gstd property set/get latency");
+  g_option_context_add_main_entries (context, entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    return EXIT_FAILURE;
+  }
+  g_option_context_free (context);
+
+  if (0 == iterations)
+    iterations = 1;
+
+  gst_init (&argc, &argv);
+
+  session = gstd_session_new ("Bench Session");
+
+  cmd = g_strdup_printf ("pipeline_create bench %s",
+      description ? description : GSTD_BENCH_DEFAULT_DESCRIPTION);
+  if (gstd_parser_parse_cmd (session, cmd, &response)
+      || gstd_get_by_uri (session, "/pipelines/bench/elements/el", &node)) {
+    g_printerr ("Unable to create the benchmark pipeline\n");
+    ret = EXIT_FAILURE;
+    goto out;
+  }
+  g_object_get (node, "gstelement", &element, NULL);
+
+  g_print ("%-20s %-20s %10s %10s %10s %10s\n", "property", "node",
+      "set ns", "generic", "get ns", "generic");
+
+  property = properties ? (const gchar * const *) properties :
+      default_properties;
+  for (; *property; property++) {
+    if (!gstd_bench_property (element, *property, iterations)) {
+      g_printerr ("\"%s\" failed\n", *property);
+      ret = EXIT_FAILURE;
+      break;
+    }
+  }
+
+out:
+  if (element)
+    g_object_unref (element);
+  if (node)
+    g_object_unref (node);
+  g_free (response);
+  g_free (cmd);
+  g_free (description);
+  g_strfreev (properties);
+  g_object_unref (session);
+
+  return ret;
+}
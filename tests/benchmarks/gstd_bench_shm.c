@@ -0,0 +1,298 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+/*
+ * Measures requests per second and latency percentiles of the shared
+ * memory IPC of a running gstd instance. Up to depth requests are kept
+ * in the request ring at any time, a depth of 1 measures round trip
+ * latency while larger depths measure throughput.
+ *
+ *   gstd --enable-shm-protocol &
+ *   gstd_bench_shm -n 100000 list_pipelines
+ *   gstd_bench_shm -n 100000 -d 32 list_pipelines
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <gio/gio.h>
+#include <gio/gunixconnection.h>
+#include <gio/gunixsocketaddress.h>
+
+#include "gstd_shm.h"
+
+#define GSTD_BENCH_DEFAULT_REQUESTS 1000
+#define GSTD_BENCH_DEFAULT_DEPTH 1
+#define GSTD_BENCH_DEFAULT_COMMAND "list_pipelines"
+
+typedef struct _GstdBench GstdBench;
+
+struct _GstdBench
+{
+  GSocketConnection *con;
+  GstdShmLayout *layout;
+  gint server_bell;
+  gint client_bell;
+  GPollFD fds[2];
+};
+
+static gint
+gstd_bench_compare (gconstpointer a, gconstpointer b)
+{
+  gint64 ia = *(const gint64 *) a;
+  gint64 ib = *(const gint64 *) b;
+
+  return ia < ib ? -1 : ia > ib;
+}
+
+static gboolean
+gstd_bench_connect (GstdBench * bench, const gchar * path, GError ** error)
+{
+  GSocketClient *client;
+  GSocketAddress *address;
+  GUnixConnection *ucon;
+  gint segment;
+
+  client = g_socket_client_new ();
+  address = g_unix_socket_address_new (path);
+  bench->con = g_socket_client_connect (client,
+      G_SOCKET_CONNECTABLE (address), NULL, error);
+  g_object_unref (address);
+  g_object_unref (client);
+  if (!bench->con) {
+    return FALSE;
+  }
+
+  ucon = G_UNIX_CONNECTION (bench->con);
+  segment = g_unix_connection_receive_fd (ucon, NULL, error);
+  if (segment < 0) {
+    return FALSE;
+  }
+  bench->server_bell = g_unix_connection_receive_fd (ucon, NULL, error);
+  if (bench->server_bell < 0) {
+    return FALSE;
+  }
+  bench->client_bell = g_unix_connection_receive_fd (ucon, NULL, error);
+  if (bench->client_bell < 0) {
+    return FALSE;
+  }
+
+  bench->layout = mmap (NULL, sizeof (GstdShmLayout), PROT_READ | PROT_WRITE,
+      MAP_SHARED, segment, 0);
+  close (segment);
+  if (MAP_FAILED == bench->layout) {
+    g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errno),
+        "Unable to map segment: %s", g_strerror (errno));
+    return FALSE;
+  }
+
+  if (GSTD_SHM_MAGIC != bench->layout->magic
+      || GSTD_SHM_VERSION != bench->layout->version
+      || GSTD_SHM_RING_SIZE != bench->layout->ring_size) {
+    g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+        "Unexpected segment layout");
+    return FALSE;
+  }
+
+  bench->fds[0].fd = bench->client_bell;
+  bench->fds[0].events = G_IO_IN;
+  bench->fds[1].fd =
+      g_socket_get_fd (g_socket_connection_get_socket (bench->con));
+  bench->fds[1].events = G_IO_IN | G_IO_HUP | G_IO_ERR;
+
+  return TRUE;
+}
+
+/* Blocks until a response is available */
+static gchar *
+gstd_bench_receive (GstdBench * bench)
+{
+  GstdShmLayout *layout = bench->layout;
+  gchar *response;
+
+  while (TRUE) {
+    response = gstd_shm_ring_pop (&layout->responses);
+    if (response) {
+      /* The server may be blocked on a full response ring */
+      if (g_atomic_int_get (&layout->server_waiting)) {
+        gstd_shm_doorbell_ring (bench->server_bell);
+      }
+      return response;
+    }
+
+    g_atomic_int_set (&layout->client_waiting, 1);
+    if (gstd_shm_ring_is_empty (&layout->responses)) {
+      if (g_poll (bench->fds, G_N_ELEMENTS (bench->fds), -1) < 0
+          && EINTR != errno) {
+        break;
+      }
+      if (bench->fds[1].revents) {
+        break;
+      }
+      gstd_shm_doorbell_clear (bench->client_bell);
+    }
+    g_atomic_int_set (&layout->client_waiting, 0);
+  }
+
+  g_atomic_int_set (&layout->client_waiting, 0);
+  return NULL;
+}
+
+static gboolean
+gstd_bench_send (GstdBench * bench, const gchar * cmd, guint32 length)
+{
+  GstdShmLayout *layout = bench->layout;
+
+  /* The depth is bounded, a full ring only means the server lags behind */
+  if (!gstd_shm_ring_push (&layout->requests, cmd, length)) {
+    return FALSE;
+  }
+
+  if (g_atomic_int_get (&layout->server_waiting)) {
+    gstd_shm_doorbell_ring (bench->server_bell);
+  }
+
+  return TRUE;
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  GstdBench bench;
+  GError *error = NULL;
+  GOptionContext *context;
+  gint64 *latencies;
+  gint64 *sent;
+  gint64 total;
+  gchar *path = NULL;
+  gchar *cmd;
+  gchar *response;
+  guint32 length;
+  guint requests = GSTD_BENCH_DEFAULT_REQUESTS;
+  guint depth = GSTD_BENCH_DEFAULT_DEPTH;
+  guint issued = 0;
+  guint done = 0;
+  gint ret = EXIT_SUCCESS;
+
+  GOptionEntry entries[] = {
+    {"shm-path", 'f', 0, G_OPTION_ARG_FILENAME, &path,
+          "The unix socket of the server (default " GSTD_SHM_DEFAULT_PATH ")",
+        "shm-path"}
+    ,
+    {"requests", 'n', 0, G_OPTION_ARG_INT, &requests,
+        "Number of requests to issue (default 1000)", "requests"}
+    ,
+    {"depth", 'd', 0, G_OPTION_ARG_INT, &depth,
+        "Number of requests in flight (default 1)", "depth"}
+    ,
+    {NULL}
+  };
+
+  memset (&bench, 0, sizeof (bench));
+  bench.layout = MAP_FAILED;
+
+  context = g_option_context_new ("[COMMAND] - gstd shared memory benchmark");
+  g_option_context_add_main_entries (context, entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    return EXIT_FAILURE;
+  }
+  g_option_context_free (context);
+
+  if (0 == depth)
+    depth = 1;
+
+  if (argc > 1) {
+    cmd = g_strjoinv (" ", argv + 1);
+  } else {
+    cmd = g_strdup (GSTD_BENCH_DEFAULT_COMMAND);
+  }
+  length = strlen (cmd);
+
+  if (!gstd_bench_connect (&bench, path ? path : GSTD_SHM_DEFAULT_PATH,
+          &error)) {
+    g_printerr ("Unable to connect: %s\n", error->message);
+    g_error_free (error);
+    requests = 0;
+    ret = EXIT_FAILURE;
+  }
+
+  latencies = g_new0 (gint64, requests);
+  sent = g_new0 (gint64, requests);
+
+  /* Responses come back in order, so each one matches the oldest send */
+  total = g_get_monotonic_time ();
+  while (done < requests) {
+    while (issued < requests && issued - done < depth) {
+      sent[issued] = g_get_monotonic_time ();
+      if (!gstd_bench_send (&bench, cmd, length)) {
+        break;
+      }
+      issued++;
+    }
+
+    response = gstd_bench_receive (&bench);
+    if (!response) {
+      g_printerr ("Request %u failed: connection closed\n", done);
+      ret = EXIT_FAILURE;
+      requests = done;
+      break;
+    }
+    g_free (response);
+    latencies[done] = g_get_monotonic_time () - sent[done];
+    done++;
+  }
+  total = g_get_monotonic_time () - total;
+
+  if (requests > 0) {
+    qsort (latencies, requests, sizeof (gint64), gstd_bench_compare);
+
+    g_print ("transport:   shm\n");
+    g_print ("depth:       %u\n", depth);
+    g_print ("command:     %s\n", cmd);
+    g_print ("requests:    %u\n", requests);
+    g_print ("req/s:       %.1f\n", requests * (gdouble) G_USEC_PER_SEC / total);
+    g_print ("p50 (us):    %" G_GINT64_FORMAT "\n", latencies[requests / 2]);
+    g_print ("p99 (us):    %" G_GINT64_FORMAT "\n",
+        latencies[(requests * 99) / 100]);
+    g_print ("max (us):    %" G_GINT64_FORMAT "\n", latencies[requests - 1]);
+  }
+
+  if (MAP_FAILED != bench.layout)
+    munmap (bench.layout, sizeof (GstdShmLayout));
+  if (bench.server_bell > 0)
+    close (bench.server_bell);
+  if (bench.client_bell > 0)
+    close (bench.client_bell);
+  if (bench.con)
+    g_object_unref (bench.con);
+  g_free (latencies);
+  g_free (sent);
+  g_free (cmd);
+  g_free (path);
+
+  return ret;
+}
@@ -0,0 +1,290 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+/*
+ * Measures requests per second and latency percentiles of a running
+ * gstd instance. Each run issues the same command repeatedly, either
+ * opening a new connection per request (oneshot), reusing a single
+ * connection (keepalive, requires gstd --keep-alive) or reusing a single
+ * connection switched to the length prefixed protocol (framed). Passing
+ * a unix socket path compares the same workload against loopback TCP.
+ *
+ *   gstd --keep-alive &
+ *   gstd-client pipeline_create p0 fakesrc ! fakesink
+ *   gstd_bench_tcp -m oneshot -n 10000 "element_get p0 fakesrc0 num-buffers"
+ *   gstd_bench_tcp -m keepalive -n 10000 "element_get p0 fakesrc0 num-buffers"
+ *
+ *   gstd --keep-alive --enable-unix-protocol --unix-keep-alive &
+ *   gstd_bench_tcp -m keepalive -n 10000 list_pipelines
+ *   gstd_bench_tcp -m keepalive -n 10000 -u /tmp/gstd_unix_socket list_pipelines
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <gio/gio.h>
+#include <gio/gunixsocketaddress.h>
+#include <gst/gst.h>
+
+#define GSTD_BENCH_DEFAULT_ADDRESS "localhost"
+#define GSTD_BENCH_DEFAULT_PORT 5000
+#define GSTD_BENCH_DEFAULT_REQUESTS 1000
+#define GSTD_BENCH_DEFAULT_COMMAND "list_pipelines"
+
+typedef struct _GstdBench GstdBench;
+
+struct _GstdBench
+{
+  GSocketClient *client;
+  GSocketConnection *con;
+  gchar *address;
+  guint port;
+  gchar *unix_path;
+  gboolean keep_alive;
+  gboolean framed;
+  GByteArray *buffer;
+};
+
+static gint
+gstd_bench_compare (gconstpointer a, gconstpointer b)
+{
+  gint64 ia = *(const gint64 *) a;
+  gint64 ib = *(const gint64 *) b;
+
+  return ia < ib ? -1 : ia > ib;
+}
+
+/* Reads until the NUL terminating the response is received */
+static gboolean
+gstd_bench_read_response (GstdBench * bench, GInputStream * istream,
+    GError ** error)
+{
+  guint8 chunk[4096];
+  gssize read;
+
+  g_byte_array_set_size (bench->buffer, 0);
+
+  while (TRUE) {
+    read = g_input_stream_read (istream, chunk, sizeof (chunk), NULL, error);
+    if (read <= 0) {
+      return FALSE;
+    }
+
+    g_byte_array_append (bench->buffer, chunk, read);
+    if ('\0' == chunk[read - 1]) {
+      return TRUE;
+    }
+  }
+}
+
+static GSocketConnection *
+gstd_bench_connect (GstdBench * bench, GError ** error)
+{
+  GSocketAddress *address;
+  GSocketConnection *con;
+
+  if (!bench->unix_path) {
+    return g_socket_client_connect_to_host (bench->client, bench->address,
+        bench->port, NULL, error);
+  }
+
+  address = g_unix_socket_address_new (bench->unix_path);
+  con = g_socket_client_connect (bench->client,
+      G_SOCKET_CONNECTABLE (address), NULL, error);
+  g_object_unref (address);
+
+  return con;
+}
+
+/* Sends a length prefixed command and reads the framed response */
+static gboolean
+gstd_bench_request_framed (GstdBench * bench, GInputStream * istream,
+    GOutputStream * ostream, const gchar * cmd, GError ** error)
+{
+  guint8 header[4];
+  gsize length = strlen (cmd);
+  gsize read;
+
+  GST_WRITE_UINT32_BE (header, length);
+  if (!g_output_stream_write_all (ostream, header, sizeof (header), NULL,
+          NULL, error)
+      || !g_output_stream_write_all (ostream, cmd, length, NULL, NULL, error)
+      || !g_input_stream_read_all (istream, header, sizeof (header), &read,
+          NULL, error) || read != sizeof (header)) {
+    return FALSE;
+  }
+
+  g_byte_array_set_size (bench->buffer, GST_READ_UINT32_BE (header));
+
+  return g_input_stream_read_all (istream, bench->buffer->data,
+      bench->buffer->len, &read, NULL, error) && read == bench->buffer->len;
+}
+
+static gboolean
+gstd_bench_request (GstdBench * bench, const gchar * cmd, GError ** error)
+{
+  GInputStream *istream;
+  GOutputStream *ostream;
+  const gchar *upgrade = "protocol framed";
+  gboolean ret;
+
+  if (!bench->con) {
+    bench->con = gstd_bench_connect (bench, error);
+    if (!bench->con) {
+      return FALSE;
+    }
+
+    if (bench->framed) {
+      istream = g_io_stream_get_input_stream (G_IO_STREAM (bench->con));
+      ostream = g_io_stream_get_output_stream (G_IO_STREAM (bench->con));
+      if (!g_output_stream_write_all (ostream, upgrade, strlen (upgrade) + 1,
+              NULL, NULL, error)
+          || !gstd_bench_read_response (bench, istream, error)) {
+        return FALSE;
+      }
+    }
+  }
+
+  istream = g_io_stream_get_input_stream (G_IO_STREAM (bench->con));
+  ostream = g_io_stream_get_output_stream (G_IO_STREAM (bench->con));
+
+  if (bench->framed) {
+    ret = gstd_bench_request_framed (bench, istream, ostream, cmd, error);
+  } else {
+    ret = g_output_stream_write_all (ostream, cmd, strlen (cmd) + 1, NULL,
+        NULL, error) && gstd_bench_read_response (bench, istream, error);
+  }
+
+  if (!ret || !(bench->keep_alive || bench->framed)) {
+    g_object_unref (bench->con);
+    bench->con = NULL;
+  }
+
+  return ret;
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  GstdBench bench;
+  GError *error = NULL;
+  GOptionContext *context;
+  gint64 *latencies;
+  gint64 start, end, total;
+  gchar *mode = NULL;
+  gchar *cmd;
+  guint requests = GSTD_BENCH_DEFAULT_REQUESTS;
+  guint i;
+  gint ret = EXIT_SUCCESS;
+
+  GOptionEntry entries[] = {
+    {"address", 'a', 0, G_OPTION_ARG_STRING, &bench.address,
+        "The address of the server (default " GSTD_BENCH_DEFAULT_ADDRESS ")",
+        "address"}
+    ,
+    {"port", 'p', 0, G_OPTION_ARG_INT, &bench.port,
+        "The port of the server (default 5000)", "port"}
+    ,
+    {"unix-path", 'u', 0, G_OPTION_ARG_FILENAME, &bench.unix_path,
+        "Connect through this unix socket instead of TCP", "unix-path"}
+    ,
+    {"mode", 'm', 0, G_OPTION_ARG_STRING, &mode,
+        "Connection mode: oneshot, keepalive or framed (default oneshot)", "mode"}
+    ,
+    {"requests", 'n', 0, G_OPTION_ARG_INT, &requests,
+        "Number of requests to issue (default 1000)", "requests"}
+    ,
+    {NULL}
+  };
+
+  bench.address = NULL;
+  bench.port = GSTD_BENCH_DEFAULT_PORT;
+  bench.unix_path = NULL;
+  bench.con = NULL;
+
+  context = g_option_context_new ("[COMMAND] - gstd TCP latency benchmark");
+  g_option_context_add_main_entries (context, entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &error)) {
+    g_printerr ("%s\n", error->message);
+    g_error_free (error);
+    return EXIT_FAILURE;
+  }
+  g_option_context_free (context);
+
+  if (!bench.address)
+    bench.address = g_strdup (GSTD_BENCH_DEFAULT_ADDRESS);
+
+  bench.keep_alive = !g_strcmp0 (mode, "keepalive");
+  bench.framed = !g_strcmp0 (mode, "framed");
+  bench.client = g_socket_client_new ();
+  bench.buffer = g_byte_array_new ();
+
+  if (argc > 1) {
+    cmd = g_strjoinv (" ", argv + 1);
+  } else {
+    cmd = g_strdup (GSTD_BENCH_DEFAULT_COMMAND);
+  }
+
+  latencies = g_new0 (gint64, requests);
+
+  total = g_get_monotonic_time ();
+  for (i = 0; i < requests; i++) {
+    start = g_get_monotonic_time ();
+    if (!gstd_bench_request (&bench, cmd, &error)) {
+      g_printerr ("Request %u failed: %s\n", i,
+          error ? error->message : "connection closed");
+      g_clear_error (&error);
+      ret = EXIT_FAILURE;
+      requests = i;
+      break;
+    }
+    end = g_get_monotonic_time ();
+    latencies[i] = end - start;
+  }
+  total = g_get_monotonic_time () - total;
+
+  if (requests > 0) {
+    qsort (latencies, requests, sizeof (gint64), gstd_bench_compare);
+
+    g_print ("transport:   %s\n", bench.unix_path ? "unix" : "tcp");
+    g_print ("mode:        %s\n", mode ? mode : "oneshot");
+    g_print ("command:     %s\n", cmd);
+    g_print ("requests:    %u\n", requests);
+    g_print ("req/s:       %.1f\n", requests * (gdouble) G_USEC_PER_SEC / total);
+    g_print ("p50 (us):    %" G_GINT64_FORMAT "\n", latencies[requests / 2]);
+    g_print ("p99 (us):    %" G_GINT64_FORMAT "\n",
+        latencies[(requests * 99) / 100]);
+    g_print ("max (us):    %" G_GINT64_FORMAT "\n", latencies[requests - 1]);
+  }
+
+  if (bench.con)
+    g_object_unref (bench.con);
+  g_object_unref (bench.client);
+  g_byte_array_free (bench.buffer, TRUE);
+  g_free (latencies);
+  g_free (cmd);
+  g_free (mode);
+  g_free (bench.address);
+  g_free (bench.unix_path);
+
+  return ret;
+}
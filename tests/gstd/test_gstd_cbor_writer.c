@@ -0,0 +1,115 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_iformatter.h"
+#include "gstd_cbor_writer.h"
+
+
+GST_START_TEST (test_encoding)
+{
+  GstdIFormatter *formatter = g_object_new (GSTD_TYPE_CBOR_WRITER, NULL);
+  GValue value = G_VALUE_INIT;
+  gchar *out = NULL;
+  const guint8 expected[] = {
+    0x00, 0x00, 0x00, 0x10,
+    0xbf,
+    0x61, 'n', 0x62, 'a', 'b',
+    0x61, 'v', 0x9f, 0x20, 0xf5, 0x19, 0x01, 0x2c, 0xff,
+    0xff
+  };
+
+  gstd_iformatter_begin_object (formatter);
+  gstd_iformatter_set_member_name (formatter, "n");
+  gstd_iformatter_set_string_value (formatter, "ab");
+  gstd_iformatter_set_member_name (formatter, "v");
+  gstd_iformatter_begin_array (formatter);
+  g_value_init (&value, G_TYPE_INT);
+  g_value_set_int (&value, -1);
+  gstd_iformatter_set_value (formatter, &value);
+  g_value_unset (&value);
+  g_value_init (&value, G_TYPE_BOOLEAN);
+  g_value_set_boolean (&value, TRUE);
+  gstd_iformatter_set_value (formatter, &value);
+  g_value_unset (&value);
+  g_value_init (&value, G_TYPE_UINT);
+  g_value_set_uint (&value, 300);
+  gstd_iformatter_set_value (formatter, &value);
+  g_value_unset (&value);
+  gstd_iformatter_end_array (formatter);
+  gstd_iformatter_end_object (formatter);
+  gstd_iformatter_generate (formatter, &out);
+
+  assert_equals_int (gstd_cbor_writer_get_size (out), sizeof (expected));
+  fail_unless (0 == memcmp (out, expected, sizeof (expected)));
+  g_free (out);
+
+  g_object_unref (formatter);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_add_encoded)
+{
+  GstdIFormatter *formatter = g_object_new (GSTD_TYPE_CBOR_WRITER, NULL);
+  gchar *inner = NULL;
+  gchar *out = NULL;
+  const guint8 expected[] = {
+    0x00, 0x00, 0x00, 0x05,
+    0x9f, 0xbf, 0xff, 0xf6, 0xff
+  };
+
+  gstd_iformatter_begin_object (formatter);
+  gstd_iformatter_end_object (formatter);
+  gstd_iformatter_generate (formatter, &inner);
+
+  /* Nested output is copied without its header */
+  gstd_iformatter_begin_array (formatter);
+  gstd_cbor_writer_add_encoded (formatter, inner);
+  gstd_cbor_writer_add_encoded (formatter, NULL);
+  gstd_iformatter_end_array (formatter);
+  gstd_iformatter_generate (formatter, &out);
+
+  assert_equals_int (gstd_cbor_writer_get_size (out), sizeof (expected));
+  fail_unless (0 == memcmp (out, expected, sizeof (expected)));
+  g_free (inner);
+  g_free (out);
+
+  g_object_unref (formatter);
+}
+GST_END_TEST;
+
+static Suite *
+gstd_cbor_writer_suite (void)
+{
+  Suite *suite = suite_create ("gstd_cbor_writer");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_encoding);
+  tcase_add_test (tc, test_add_encoded);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_cbor_writer);
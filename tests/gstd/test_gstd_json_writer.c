@@ -0,0 +1,111 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_iformatter.h"
+#include "gstd_json_writer.h"
+
+
+GST_START_TEST (test_layout)
+{
+  GstdIFormatter *formatter = g_object_new (GSTD_TYPE_JSON_WRITER, NULL);
+  GValue value = G_VALUE_INIT;
+  gchar *out = NULL;
+
+  gstd_iformatter_begin_object (formatter);
+  gstd_iformatter_set_member_name (formatter, "name");
+  gstd_iformatter_set_string_value (formatter, "fakesrc0");
+  gstd_iformatter_set_member_name (formatter, "values");
+  gstd_iformatter_begin_array (formatter);
+  g_value_init (&value, G_TYPE_INT);
+  g_value_set_int (&value, -1);
+  gstd_iformatter_set_value (formatter, &value);
+  g_value_unset (&value);
+  g_value_init (&value, G_TYPE_BOOLEAN);
+  g_value_set_boolean (&value, TRUE);
+  gstd_iformatter_set_value (formatter, &value);
+  g_value_unset (&value);
+  gstd_iformatter_end_array (formatter);
+  gstd_iformatter_set_member_name (formatter, "empty");
+  gstd_iformatter_begin_array (formatter);
+  gstd_iformatter_end_array (formatter);
+  gstd_iformatter_end_object (formatter);
+  gstd_iformatter_generate (formatter, &out);
+
+  assert_equals_string (out,
+      "{\n"
+      "    \"name\" : \"fakesrc0\",\n"
+      "    \"values\" : [\n"
+      "        -1,\n"
+      "        true\n"
+      "    ],\n"
+      "    \"empty\" : []\n"
+      "}");
+  g_free (out);
+  out = NULL;
+
+  /* The writer starts over after generating */
+  gstd_iformatter_begin_array (formatter);
+  gstd_iformatter_end_array (formatter);
+  gstd_iformatter_generate (formatter, &out);
+  assert_equals_string (out, "[]");
+  g_free (out);
+
+  g_object_unref (formatter);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_escape)
+{
+  GstdIFormatter *formatter = g_object_new (GSTD_TYPE_JSON_WRITER, NULL);
+  gchar *out = NULL;
+
+  /* Long enough for the escapes to fall in and out of whole words */
+  gstd_iformatter_set_string_value (formatter,
+      "quote \" backslash \\ newline \n tab \t bell \a plain text é");
+  gstd_iformatter_generate (formatter, &out);
+
+  assert_equals_string (out,
+      "\"quote \\\" backslash \\\\ newline \\n tab \\t bell \\u0007 "
+      "plain text é\"");
+  g_free (out);
+
+  g_object_unref (formatter);
+}
+GST_END_TEST;
+
+static Suite *
+gstd_json_writer_suite (void)
+{
+  Suite *suite = suite_create ("gstd_json_writer");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_layout);
+  tcase_add_test (tc, test_escape);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_json_writer);
@@ -0,0 +1,856 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/check/gstcheck.h>
+
+#include "gstd_session.h"
+#include "gstd_parser.h"
+#include "gstd_cbor_writer.h"
+#include "gstd_property.h"
+#include "gstd_property_int.h"
+
+
+static GstdSession *
+gstd_parser_test_session (void)
+{
+  GstdSession *test_session = gstd_session_new ("Test Session");
+  GstdReturnCode ret;
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "pipeline_create p0 fakesrc name=src num-buffers=5 ! fakesink",
+      &response);
+  fail_if (ret);
+  g_free (response);
+
+  return test_session;
+}
+
+static gint
+gstd_parser_test_num_buffers (GstdSession * test_session)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+  gint num_buffers;
+
+  ret = gstd_get_by_uri (test_session,
+      "/pipelines/p0/elements/src/properties/num-buffers", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  g_object_get (GSTD_PROPERTY (node)->target, "num-buffers", &num_buffers,
+      NULL);
+  gst_object_unref (node);
+
+  return num_buffers;
+}
+
+GST_START_TEST (test_batch)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "batch [\"element_set p0 src num-buffers 10\", "
+      "\"element_set p0 src non-existent 1\", "
+      "\"update /pipelines/p0/elements/src/properties/num-buffers 20\"]",
+      &response);
+  fail_if (ret != GSTD_BAD_COMMAND);
+  fail_if (NULL == response);
+  g_free (response);
+
+  /* Non atomic batches run every command */
+  fail_if (20 != gstd_parser_test_num_buffers (test_session));
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_batch_atomic)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "batch atomic [\"element_set p0 src num-buffers 10\", "
+      "\"update /pipelines/p0/elements/src/properties/num-buffers 20\", "
+      "\"element_set p0 src non-existent 1\"]", &response);
+  fail_if (ret != GSTD_BAD_COMMAND);
+  g_free (response);
+
+  /* Both updates are rolled back */
+  fail_if (5 != gstd_parser_test_num_buffers (test_session));
+
+  response = NULL;
+  ret = gstd_parser_parse_cmd (test_session,
+      "batch atomic [\"element_set p0 src num-buffers 10\"]", &response);
+  fail_if (ret);
+  g_free (response);
+
+  fail_if (10 != gstd_parser_test_num_buffers (test_session));
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_batch_malformed)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session, "batch element_set p0",
+      &response);
+  fail_if (ret != GSTD_BAD_COMMAND);
+  fail_if (NULL != response);
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "batch [\"batch [\\\"list_pipelines\\\"]\"]", &response);
+  fail_if (ret != GSTD_BAD_COMMAND);
+  g_free (response);
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_batch_raw)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "create /batch atomic [\"element_set p0 src num-buffers 10\", "
+      "\"element_set p0 src non-existent 1\"]", &response);
+  fail_if (ret != GSTD_BAD_COMMAND);
+  fail_if (NULL == response);
+  g_free (response);
+
+  fail_if (5 != gstd_parser_test_num_buffers (test_session));
+
+  response = NULL;
+  ret = gstd_parser_parse_cmd (test_session,
+      "create /batch [\"element_set p0 src num-buffers 10\"]", &response);
+  fail_if (ret);
+  g_free (response);
+
+  fail_if (10 != gstd_parser_test_num_buffers (test_session));
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+typedef struct
+{
+  GMutex mutex;
+  GCond cond;
+  gboolean done;
+  GstdReturnCode ret;
+  gchar *response;
+} GstdParserTestAsync;
+
+static void
+gstd_parser_test_ready (GstdReturnCode ret, gchar * response,
+    gpointer user_data)
+{
+  GstdParserTestAsync *async = user_data;
+
+  g_mutex_lock (&async->mutex);
+  async->ret = ret;
+  async->response = response;
+  async->done = TRUE;
+  g_cond_signal (&async->cond);
+  g_mutex_unlock (&async->mutex);
+}
+
+GST_START_TEST (test_bus_read_cancelled)
+{
+  GstdSession *test_session = gstd_parser_test_session ();
+  GCancellable *cancellable = g_cancellable_new ();
+  GstdParserTestAsync async = { 0 };
+
+  g_mutex_init (&async.mutex);
+  g_cond_init (&async.cond);
+
+  /* Nothing is posted on an idle pipeline, so the read waits forever
+   * unless it is abandoned */
+  gstd_parser_parse_cmd_async (test_session, "bus_read p0", cancellable,
+      gstd_parser_test_ready, &async);
+  g_cancellable_cancel (cancellable);
+
+  g_mutex_lock (&async.mutex);
+  while (!async.done) {
+    g_cond_wait (&async.cond, &async.mutex);
+  }
+  g_mutex_unlock (&async.mutex);
+
+  fail_if (async.ret);
+  fail_if (NULL != async.response);
+
+  g_mutex_clear (&async.mutex);
+  g_cond_clear (&async.cond);
+  g_object_unref (cancellable);
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+static void
+gstd_parser_test_notify (GstdPipelineBusSubscription * sub,
+    gpointer user_data)
+{
+  guint *notified = user_data;
+
+  (*notified)++;
+}
+
+GST_START_TEST (test_bus_subscribe)
+{
+  GstdSession *test_session = gstd_parser_test_session ();
+  GstdPipelineBusSubscription *sub = NULL;
+  GstdObject *node;
+  GstMessage *message;
+  GstBus *bus;
+  GstdReturnCode ret;
+  gchar args[] = "p0 application";
+  gchar *event;
+  guint notified = 0;
+  guint dropped;
+  guint i;
+
+  ret = gstd_parser_bus_subscribe (test_session, args, 1,
+      gstd_parser_test_notify, &notified, NULL, &sub);
+  fail_if (ret);
+  fail_if (NULL == sub);
+
+  ret = gstd_get_by_uri (test_session, "/pipelines/p0/bus", &node);
+  fail_if (ret);
+  bus = gstd_pipeline_bus_get_bus (GSTD_PIPELINE_BUS (node));
+
+  /* Only the first one fits in the queue, filtered out messages don't
+   * count as dropped */
+  for (i = 0; i < 3; i++) {
+    gst_bus_post (bus, gst_message_new_application (NULL,
+            gst_structure_new_empty ("test")));
+  }
+  gst_bus_post (bus, gst_message_new_eos (NULL));
+  fail_if (1 != notified);
+
+  message = gstd_pipeline_bus_subscription_pop (sub, &dropped);
+  fail_if (NULL == message);
+  fail_if (2 != dropped);
+
+  event = gstd_parser_bus_event (message, dropped);
+  fail_if (NULL == strstr (event, "\"dropped\" : 2"));
+  g_free (event);
+  gst_message_unref (message);
+
+  fail_if (NULL != gstd_pipeline_bus_subscription_pop (sub, NULL));
+
+  /* Subscribers get copies, readers still see every message */
+  message = gst_bus_pop_filtered (bus, GST_MESSAGE_APPLICATION);
+  fail_if (NULL == message);
+  gst_message_unref (message);
+
+  gstd_pipeline_bus_unsubscribe (sub);
+  gst_object_unref (bus);
+  gst_object_unref (node);
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+static void
+gstd_parser_test_changed (GstdPropertyWatch * watch, gpointer user_data)
+{
+  gchar **event = user_data;
+
+  g_free (*event);
+  *event = gstd_parser_watch_event ("p0/src/num-buffers", watch);
+}
+
+GST_START_TEST (test_watch)
+{
+  GstdSession *test_session = gstd_parser_test_session ();
+  GstdPropertyWatch *watch = NULL;
+  GMainContext *context = g_main_context_new ();
+  GstdReturnCode ret;
+  gchar args[] =
+      "/pipelines/p0/elements/src/properties/num-buffers interval=0";
+  gchar bad[] = "/pipelines/p0/elements/src interval=0";
+  gchar *event = NULL;
+  gchar *response = NULL;
+
+  ret = gstd_parser_watch (test_session, bad, context,
+      gstd_parser_test_changed, &event, NULL, &watch);
+  assert_equals_int (GSTD_BAD_COMMAND, ret);
+
+  ret = gstd_parser_watch (test_session, args, context,
+      gstd_parser_test_changed, &event, NULL, &watch);
+  fail_if (ret);
+  fail_if (NULL == watch);
+
+  /* The current value is reported first */
+  while (!event) {
+    g_main_context_iteration (context, TRUE);
+  }
+  fail_if (NULL == strstr (event, "\"value\" : \"5\""));
+  fail_if (NULL != strstr (event, "param_spec"));
+  g_clear_pointer (&event, g_free);
+
+  /* Setting the same value again is not a change */
+  ret = gstd_parser_parse_cmd (test_session, "element_set p0 src num-buffers 5",
+      &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+  while (g_main_context_iteration (context, FALSE));
+  fail_if (NULL != event);
+
+  ret = gstd_parser_parse_cmd (test_session, "element_set p0 src num-buffers 7",
+      &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+  while (!event) {
+    g_main_context_iteration (context, TRUE);
+  }
+  fail_if (NULL == strstr (event, "\"value\" : \"7\""));
+  fail_if (NULL == strstr (event, "\"watch\" : \"p0/src/num-buffers\""));
+  g_free (event);
+
+  /* The client's URI is escaped like any other string */
+  event = gstd_parser_watch_event ("p0/\"src\"", watch);
+  fail_if (NULL == strstr (event, "\"watch\" : \"p0/\\\"src\\\"\""));
+  g_free (event);
+
+  gstd_property_unwatch (watch);
+  g_main_context_unref (context);
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_typed_properties)
+{
+  GstdSession *test_session = gstd_parser_test_session ();
+  GstdObject *node;
+  GstdReturnCode ret;
+  gchar *response = NULL;
+
+  ret = gstd_get_by_uri (test_session,
+      "/pipelines/p0/elements/src/properties/num-buffers", &node);
+  fail_if (ret);
+  fail_unless (GSTD_IS_PROPERTY_INT (node));
+  g_object_unref (node);
+
+  /* Values are checked against the range of the property */
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_set p0 src num-buffers -2", &response);
+  assert_equals_int (GSTD_BAD_VALUE, ret);
+  g_clear_pointer (&response, g_free);
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_set p0 src num-buffers 7x", &response);
+  assert_equals_int (GSTD_BAD_VALUE, ret);
+  g_clear_pointer (&response, g_free);
+  assert_equals_int (5, gstd_parser_test_num_buffers (test_session));
+
+  /* Numbers in any base and the limits of the type, like
+   * gst_value_deserialize() takes them */
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_set p0 src num-buffers 0x10", &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+  assert_equals_int (16, gstd_parser_test_num_buffers (test_session));
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_set p0 src num-buffers max", &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+  assert_equals_int (G_MAXINT, gstd_parser_test_num_buffers (test_session));
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_set p0 src num-buffers 7", &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+
+  ret = gstd_parser_parse_cmd (test_session, "element_get p0 src num-buffers",
+      &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"value\" : \"7\""));
+  g_clear_pointer (&response, g_free);
+
+  ret = gstd_parser_parse_cmd (test_session, "element_set p0 src is-live yes",
+      &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+
+  ret = gstd_parser_parse_cmd (test_session, "element_get p0 src is-live",
+      &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"value\" : \"true\""));
+  g_clear_pointer (&response, g_free);
+
+  /* Enums by nick or number, as long as the number is one of them */
+  ret = gstd_parser_parse_cmd (test_session, "element_set p0 src filltype random",
+      &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+
+  ret = gstd_parser_parse_cmd (test_session, "element_set p0 src filltype 99",
+      &response);
+  assert_equals_int (GSTD_BAD_VALUE, ret);
+  g_clear_pointer (&response, g_free);
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+/* Whether the CBOR output contains the given bytes */
+static gboolean
+gstd_parser_test_cbor_contains (const gchar * output, const gchar * bytes,
+    gsize length)
+{
+  gsize size = gstd_cbor_writer_get_size (output);
+  gsize i;
+
+  for (i = 0; i + length <= size; i++) {
+    if (0 == memcmp (output + i, bytes, length)) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+GST_START_TEST (test_binary_values)
+{
+  GstdSession *test_session = gstd_parser_test_session ();
+  GstdReturnCode ret;
+  gchar *response = NULL;
+
+  /* CBOR carries numbers and booleans natively: "value" followed by an
+   * unsigned 5 and then by false, not by the strings "5" and "false" */
+  gstd_object_set_binary (TRUE);
+
+  ret = gstd_parser_parse_cmd (test_session, "element_get p0 src num-buffers",
+      &response);
+  fail_if (ret);
+  fail_unless (gstd_parser_test_cbor_contains (response, "\x65value\x05", 7));
+  g_clear_pointer (&response, g_free);
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_get_many p0 src num-buffers is-live", &response);
+  fail_if (ret);
+  fail_unless (gstd_parser_test_cbor_contains (response, "\x65value\x05", 7));
+  fail_unless (gstd_parser_test_cbor_contains (response, "\x65value\xf4", 7));
+  g_clear_pointer (&response, g_free);
+
+  gstd_object_set_binary (FALSE);
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+static gdouble
+gstd_parser_test_volume (GstdObject * node)
+{
+  gdouble volume;
+
+  g_object_get (GSTD_PROPERTY (node)->target, "volume", &volume, NULL);
+
+  return volume;
+}
+
+GST_START_TEST (test_ramp)
+{
+  GstdSession *test_session = gstd_parser_test_session ();
+  GstControlBinding *binding;
+  GstdObject *node;
+  GstdReturnCode ret;
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "pipeline_create ramp audiotestsrc name=src ! fakesink", &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_ramp ramp src volume 0.5 1000000000 cubic", &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+
+  ret = gstd_get_by_uri (test_session,
+      "/pipelines/ramp/elements/src/properties/volume", &node);
+  fail_if (ret);
+
+  binding = gst_object_get_control_binding (GST_OBJECT (GSTD_PROPERTY
+          (node)->target), "volume");
+  fail_if (NULL == binding);
+  gst_object_unref (binding);
+
+  /* Explicit values stop the ramp */
+  ret = gstd_parser_parse_cmd (test_session, "element_set ramp src volume 0.3",
+      &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+  fail_if (gst_object_has_active_control_bindings (GST_OBJECT (GSTD_PROPERTY
+              (node)->target)));
+  fail_unless (0.3 == gstd_parser_test_volume (node));
+
+  /* A zero duration jumps right to the target */
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_ramp ramp src volume 0.25 0", &response);
+  fail_if (ret);
+  g_clear_pointer (&response, g_free);
+  fail_unless (0.25 == gstd_parser_test_volume (node));
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_ramp ramp src volume -5 1000", &response);
+  assert_equals_int (GSTD_BAD_VALUE, ret);
+  g_clear_pointer (&response, g_free);
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_ramp ramp src volume 0.5 1000 wobbly", &response);
+  assert_equals_int (GSTD_BAD_VALUE, ret);
+  g_clear_pointer (&response, g_free);
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_ramp ramp src is-live 1 1000", &response);
+  assert_equals_int (GSTD_BAD_VALUE, ret);
+  g_clear_pointer (&response, g_free);
+
+  /* Numeric but not controllable, nothing gets bound */
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_ramp p0 src num-buffers 10 1000", &response);
+  assert_equals_int (GSTD_BAD_VALUE, ret);
+  g_clear_pointer (&response, g_free);
+  assert_equals_int (5, gstd_parser_test_num_buffers (test_session));
+
+  g_object_unref (node);
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_list_page)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "pipeline_create p1 fakesrc ! fakesink", &response);
+  fail_if (ret);
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "pipeline_create q0 fakesrc ! fakesink", &response);
+  fail_if (ret);
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "list_pipelines prefix=p offset=1 limit=1", &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"p1\""));
+  fail_if (NULL != strstr (response, "\"p0\""));
+  fail_if (NULL != strstr (response, "\"q0\""));
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session, "list_pipelines limit=x",
+      &response);
+  fail_if (GSTD_BAD_VALUE != ret);
+  g_free (response);
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_list_properties_lazy)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "pipeline_create lazy fakesrc name=src ! fakesink", &response);
+  fail_if (ret);
+  g_free (response);
+  response = NULL;
+
+  /* Properties never accessed are still listed */
+  ret = gstd_parser_parse_cmd (test_session, "list_properties lazy src",
+      &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"num-buffers\""));
+  fail_if (NULL == strstr (response, "\"sizetype\""));
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_set lazy src num-buffers 5", &response);
+  fail_if (ret);
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_get lazy src num-buffers", &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "5"));
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_get lazy src no-such-property", &response);
+  fail_if (GSTD_EOK == ret);
+  g_free (response);
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_list_properties_alias)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  GstdObject *canonical = NULL;
+  GstdObject *alias = NULL;
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "pipeline_create alias fakesrc name=src ! fakesink", &response);
+  fail_if (ret);
+  g_free (response);
+
+  /* A non canonical name reaches the node of the canonical one */
+  ret = gstd_get_by_uri (test_session,
+      "/pipelines/alias/elements/src/properties/num_buffers", &alias);
+  fail_if (ret);
+  ret = gstd_get_by_uri (test_session,
+      "/pipelines/alias/elements/src/properties/num-buffers", &canonical);
+  fail_if (ret);
+  fail_if (alias != canonical);
+  fail_if (g_strcmp0 (GSTD_OBJECT_NAME (alias), "num-buffers"));
+
+  g_object_unref (alias);
+  g_object_unref (canonical);
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_compact)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  gchar *response = NULL;
+  gchar *envelope;
+
+  gstd_object_set_pretty (FALSE);
+
+  ret = gstd_parser_parse_cmd (test_session, "list_elements p0", &response);
+  fail_if (ret);
+  fail_if (NULL != strchr (response, '\n'));
+  fail_if (NULL != strstr (response, " : "));
+
+  envelope = gstd_parser_envelope (ret, response, NULL);
+  fail_if (NULL != strchr (envelope, '\n'));
+  fail_if (!g_str_has_prefix (envelope, "{\"code\":0,"));
+  g_free (envelope);
+  g_free (response);
+
+  gstd_object_set_pretty (TRUE);
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_fields)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "pipeline_create fields fakesrc name=src ! fakesink", &response);
+  fail_if (ret);
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_get fields src num-buffers fields=value", &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"value\""));
+  fail_if (NULL != strstr (response, "\"name\""));
+  fail_if (NULL != strstr (response, "\"param_spec\""));
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "read /pipelines/fields/elements/src fields=name,value", &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"num-buffers\""));
+  fail_if (NULL != strstr (response, "\"blurb\""));
+  g_free (response);
+  response = NULL;
+
+  /* The projection only lasts for the command */
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_get fields src num-buffers", &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"param_spec\""));
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_get fields src num-buffers fields=blurb", &response);
+  assert_equals_int (ret, GSTD_BAD_VALUE);
+  g_free (response);
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_element_many)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "pipeline_create many fakesrc name=src ! fakesink", &response);
+  fail_if (ret);
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_set_many many src num-buffers=7 format=time "
+      "filltype=\"random\"", &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"num-buffers\""));
+  fail_if (NULL == strstr (response, "\"filltype\""));
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_get_many many src num-buffers format", &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"value\" : \"7\""));
+  fail_if (NULL != strstr (response, "\"filltype\""));
+  g_free (response);
+  response = NULL;
+
+  /* A bad value leaves every property untouched */
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_set_many many src num-buffers=9 sizemax=big", &response);
+  assert_equals_int (ret, GSTD_BAD_VALUE);
+  g_free (response);
+  response = NULL;
+
+  /* So does one out of the range of its property */
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_set_many many src num-buffers=9 sizemax=-5", &response);
+  assert_equals_int (ret, GSTD_BAD_VALUE);
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_get_many many src num-buffers", &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "7"));
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "element_get_many many src no-such-property", &response);
+  assert_equals_int (ret, GSTD_NO_RESOURCE);
+  g_free (response);
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_snapshot)
+{
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_parser_test_session ();
+  gchar *response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "pipeline_create snap fakesrc name=src num-buffers=3 ! "
+      "fakesink name=sink", &response);
+  fail_if (ret);
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session,
+      "pipeline_snapshot snap properties=num-buffers,sync", &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"src\""));
+  fail_if (NULL == strstr (response, "\"sink\""));
+  fail_if (NULL == strstr (response, "\"num-buffers\""));
+  fail_if (NULL == strstr (response, "\"sync\""));
+  fail_if (NULL != strstr (response, "\"sizemax\""));
+  /* Values are written like the property nodes write them */
+  fail_if (NULL == strstr (response, "\"3\""));
+  g_free (response);
+  response = NULL;
+
+  ret = gstd_parser_parse_cmd (test_session, "pipeline_snapshot snap",
+      &response);
+  fail_if (ret);
+  fail_if (NULL == strstr (response, "\"sizemax\""));
+  g_free (response);
+
+  gst_object_unref (test_session);
+}
+GST_END_TEST;
+
+static Suite *
+gstd_parser_suite (void)
+{
+  Suite *suite = suite_create ("gstd_parser");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_batch);
+  tcase_add_test (tc, test_batch_atomic);
+  tcase_add_test (tc, test_batch_malformed);
+  tcase_add_test (tc, test_batch_raw);
+  tcase_add_test (tc, test_bus_read_cancelled);
+  tcase_add_test (tc, test_bus_subscribe);
+  tcase_add_test (tc, test_watch);
+  tcase_add_test (tc, test_list_page);
+  tcase_add_test (tc, test_list_properties_lazy);
+  tcase_add_test (tc, test_list_properties_alias);
+  tcase_add_test (tc, test_compact);
+  tcase_add_test (tc, test_fields);
+  tcase_add_test (tc, test_element_many);
+  tcase_add_test (tc, test_snapshot);
+  tcase_add_test (tc, test_typed_properties);
+  tcase_add_test (tc, test_binary_values);
+  tcase_add_test (tc, test_ramp);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_parser);
@@ -82,6 +82,99 @@ GST_START_TEST (test_pipeline_create_erroneous_description)
 }
 GST_END_TEST;
 
+GST_START_TEST (test_pipeline_create_order)
+{
+  GstdObject *node;
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  const gchar *names[] = { "p0", "p1", "p2" };
+  gchar *output = NULL;
+  gchar *p0, *p1, *p2;
+  guint count;
+  guint i;
+
+  ret = gstd_get_by_uri (test_session, "/pipelines", &node);
+  fail_if (ret);
+  fail_if (NULL == node);
+
+  for (i = 0; i < G_N_ELEMENTS (names); i++) {
+    ret = gstd_object_create (node, names[i], "fakesrc ! fakesink");
+    fail_if (GSTD_EOK != ret);
+  }
+
+  ret = gstd_object_create (node, "p1", "fakesrc ! fakesink");
+  fail_if (GSTD_EXISTING_RESOURCE != ret);
+
+  /* Nodes are listed in creation order */
+  ret = gstd_object_delete (node, "p1");
+  fail_if (GSTD_EOK != ret);
+  ret = gstd_object_create (node, "p1", "fakesrc ! fakesink");
+  fail_if (GSTD_EOK != ret);
+
+  g_object_get (node, "count", &count, NULL);
+  fail_if (3 != count);
+
+  ret = gstd_object_to_string (node, &output);
+  fail_if (GSTD_EOK != ret);
+  p0 = strstr (output, "\"p0\"");
+  p1 = strstr (output, "\"p1\"");
+  p2 = strstr (output, "\"p2\"");
+  fail_if (!p0 || !p1 || !p2);
+  fail_if (p0 > p2 || p2 > p1);
+  g_free (output);
+
+  gst_object_unref(node);
+  gst_object_unref(test_session);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_pipeline_uri_cache)
+{
+  GstdObject *node;
+  GstdObject *pipeline;
+  GstdObject *cached;
+  GstdReturnCode ret;
+  GstdSession *test_session = gstd_session_new ("Test_session");
+  guint hits;
+
+  ret = gstd_get_by_uri (test_session, "/pipelines", &node);
+  fail_if (ret);
+  ret = gstd_object_create (node, "p0", "fakesrc ! fakesink");
+  fail_if (GSTD_EOK != ret);
+
+  ret = gstd_get_by_uri (test_session, "/pipelines/p0", &pipeline);
+  fail_if (ret);
+
+  /* Equivalent URIs share the entry */
+  ret = gstd_get_by_uri (test_session, "pipelines//p0/", &cached);
+  fail_if (ret);
+  fail_if (pipeline != cached);
+  g_object_get (test_session, "uri-cache-hits", &hits, NULL);
+  fail_if (1 != hits);
+  gst_object_unref (cached);
+
+  /* Creating a sibling leaves the entry in place */
+  ret = gstd_object_create (node, "p1", "fakesrc ! fakesink");
+  fail_if (GSTD_EOK != ret);
+  ret = gstd_get_by_uri (test_session, "/pipelines/p0", &cached);
+  fail_if (ret);
+  fail_if (pipeline != cached);
+  g_object_get (test_session, "uri-cache-hits", &hits, NULL);
+  fail_if (2 != hits);
+  gst_object_unref (cached);
+  gst_object_unref (pipeline);
+
+  /* Deleting invalidates the entry */
+  ret = gstd_object_delete (node, "p0");
+  fail_if (GSTD_EOK != ret);
+  ret = gstd_get_by_uri (test_session, "/pipelines/p0", &pipeline);
+  fail_if (GSTD_BAD_COMMAND != ret);
+
+  gst_object_unref(node);
+  gst_object_unref(test_session);
+}
+GST_END_TEST;
+
 
 static Suite *
 gstd_pipeline_create_suite (void)
@@ -94,6 +187,8 @@ gstd_pipeline_create_suite (void)
   tcase_add_test (tc, test_pipeline_create_no_name);
   tcase_add_test (tc, test_pipeline_create_no_description);
   tcase_add_test (tc, test_pipeline_create_erroneous_description);
+  tcase_add_test (tc, test_pipeline_create_order);
+  tcase_add_test (tc, test_pipeline_uri_cache);
 
   return suite;
 }
@@ -0,0 +1,66 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <gst/check/gstcheck.h>
+
+#include "gstd_schema.h"
+
+
+GST_START_TEST (test_shared)
+{
+  GstElement *first = gst_element_factory_make ("fakesrc", NULL);
+  GstElement *second = gst_element_factory_make ("fakesrc", NULL);
+  const GstdSchema *schema;
+  const GstdSchemaProperty *property;
+
+  schema = gstd_schema_get (G_OBJECT_TYPE (first));
+  fail_unless (schema == gstd_schema_get (G_OBJECT_TYPE (second)));
+  fail_unless (schema->n_properties > 0);
+
+  property = gstd_schema_find (schema, "num-buffers");
+  fail_if (NULL == property);
+  assert_equals_string (property->type_name, "gint");
+  fail_if (NULL == property->access);
+
+  /* Names are resolved like GObject does */
+  fail_unless (property == gstd_schema_find (schema, "num_buffers"));
+  fail_unless (NULL == gstd_schema_find (schema, "no-such-property"));
+
+  gst_object_unref (first);
+  gst_object_unref (second);
+}
+GST_END_TEST;
+
+static Suite *
+gstd_schema_suite (void)
+{
+  Suite *suite = suite_create ("gstd_schema");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_shared);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_schema);
@@ -0,0 +1,393 @@
+/*
+ * GStreamer Daemon - Gst Launch under steroids
+ * Copyright (c) 2015-2017 Ridgerun, LLC (http://www.ridgerun.com)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <string.h>
+#include <glib/gstdio.h>
+#include <gio/gunixsocketaddress.h>
+#include <gst/check/gstcheck.h>
+
+#include "gstd_parser.h"
+#include "gstd_session.h"
+#include "gstd_unix.h"
+
+
+typedef struct _GstdSocketTest
+{
+  GstdSession *session;
+  GstdIpc *ipc;
+  gchar *dir;
+  gchar *path;
+  GSocketClient *client;
+  GSocketConnection *connection;
+  GInputStream *istream;
+  GOutputStream *ostream;
+} GstdSocketTest;
+
+/* Serves a fresh session with a p0 pipeline over a temporary unix socket
+ * and connects a client to it */
+static void
+gstd_socket_test_setup (GstdSocketTest * test, gboolean keep_alive,
+    guint idle_timeout)
+{
+  GSocketAddress *address;
+  gchar *response = NULL;
+
+  test->session = gstd_session_new ("Test Session");
+  fail_if (gstd_parser_parse_cmd (test->session,
+          "pipeline_create p0 fakesrc ! fakesink", &response));
+  g_free (response);
+
+  test->dir = g_dir_make_tmp ("gstd-socket-XXXXXX", NULL);
+  fail_unless (test->dir);
+  test->path = g_build_filename (test->dir, "socket", NULL);
+
+  test->ipc = g_object_new (GSTD_TYPE_UNIX, "path", test->path,
+      "keep-alive", keep_alive, "idle-timeout", idle_timeout, NULL);
+  test->ipc->enabled = TRUE;
+  fail_if (gstd_ipc_start (test->ipc, test->session));
+
+  test->client = g_socket_client_new ();
+  g_socket_client_set_timeout (test->client, 5);
+  address = g_unix_socket_address_new (test->path);
+  test->connection = g_socket_client_connect (test->client,
+      G_SOCKET_CONNECTABLE (address), NULL, NULL);
+  g_object_unref (address);
+  fail_unless (test->connection);
+
+  test->istream =
+      g_io_stream_get_input_stream (G_IO_STREAM (test->connection));
+  test->ostream =
+      g_io_stream_get_output_stream (G_IO_STREAM (test->connection));
+}
+
+static void
+gstd_socket_test_teardown (GstdSocketTest * test)
+{
+  g_object_unref (test->connection);
+  g_object_unref (test->client);
+
+  gstd_ipc_stop (test->ipc);
+  g_object_unref (test->ipc);
+  gst_object_unref (test->session);
+
+  g_rmdir (test->dir);
+  g_free (test->path);
+  g_free (test->dir);
+}
+
+static void
+gstd_socket_test_send (GOutputStream * ostream, const gchar * message,
+    gboolean framed)
+{
+  guint8 header[GSTD_SOCKET_FRAME_HEADER_SIZE];
+  gsize length = strlen (message);
+
+  if (framed) {
+    GST_WRITE_UINT32_BE (header, length);
+    fail_unless (g_output_stream_write_all (ostream, header, sizeof (header),
+            NULL, NULL, NULL));
+  } else {
+    /* Text commands are NUL terminated */
+    length++;
+  }
+
+  fail_unless (g_output_stream_write_all (ostream, message, length, NULL,
+          NULL, NULL));
+}
+
+/* Reads a framed reply. Text and CBOR replies both start with the size
+ * of what follows */
+static GBytes *
+gstd_socket_test_receive (GInputStream * istream)
+{
+  guint8 header[GSTD_SOCKET_FRAME_HEADER_SIZE];
+  guint32 length;
+  guint8 *payload;
+
+  fail_unless (g_input_stream_read_all (istream, header, sizeof (header),
+          NULL, NULL, NULL));
+  length = GST_READ_UINT32_BE (header);
+  fail_if (length > 4096);
+
+  payload = g_malloc (length);
+  fail_unless (g_input_stream_read_all (istream, payload, length, NULL, NULL,
+          NULL));
+
+  return g_bytes_new_take (payload, length);
+}
+
+static void
+gstd_socket_test_expect_cbor (GInputStream * istream)
+{
+  GBytes *reply = gstd_socket_test_receive (istream);
+  gsize length;
+  const guint8 *data = g_bytes_get_data (reply, &length);
+
+  /* An indefinite length map, closed by a break */
+  fail_unless (length > 2);
+  fail_unless (0xbf == data[0]);
+  fail_unless (0xff == data[length - 1]);
+  g_bytes_unref (reply);
+}
+
+static void
+gstd_socket_test_expect_compact (GInputStream * istream)
+{
+  GBytes *reply = gstd_socket_test_receive (istream);
+  gsize length;
+  const gchar *data = g_bytes_get_data (reply, &length);
+
+  fail_unless (length > 2);
+  fail_unless ('{' == data[0]);
+  fail_unless ('}' == data[length - 1]);
+  fail_if (memchr (data, '\n', length));
+  fail_unless (g_strstr_len (data, length, "\"code\":0"));
+  g_bytes_unref (reply);
+}
+
+/* Reads a NUL terminated text reply, NULL if the server closed the
+ * connection instead */
+static gchar *
+gstd_socket_test_receive_text (GInputStream * istream)
+{
+  GString *reply = g_string_new (NULL);
+  gchar c;
+
+  while (TRUE) {
+    gssize read = g_input_stream_read (istream, &c, 1, NULL, NULL);
+
+    fail_if (read < 0);
+    if (0 == read) {
+      fail_unless (0 == reply->len);
+      g_string_free (reply, TRUE);
+      return NULL;
+    }
+
+    if ('\0' == c) {
+      return g_string_free (reply, FALSE);
+    }
+    g_string_append_c (reply, c);
+  }
+}
+
+/* Switches the connection to framed compact replies */
+static void
+gstd_socket_test_frame (GstdSocketTest * test)
+{
+  gchar *reply;
+
+  /* The protocol reply is still text */
+  gstd_socket_test_send (test->ostream, "protocol framed", FALSE);
+  reply = gstd_socket_test_receive_text (test->istream);
+  fail_unless (reply);
+  g_free (reply);
+
+  gstd_socket_test_send (test->ostream, "format compact", TRUE);
+  gstd_socket_test_expect_compact (test->istream);
+}
+
+/* Reads a framed compact reply to a tagged request and returns its id */
+static guint
+gstd_socket_test_receive_id (GInputStream * istream)
+{
+  GBytes *reply = gstd_socket_test_receive (istream);
+  gsize length;
+  const gchar *data = g_bytes_get_data (reply, &length);
+  gchar *text = g_strndup (data, length);
+  guint id = 0;
+
+  fail_unless (1 == sscanf (text, "{\"id\":%u,", &id));
+  g_free (text);
+  g_bytes_unref (reply);
+
+  return id;
+}
+
+GST_START_TEST (test_format_switch)
+{
+  GstdSocketTest test;
+
+  gstd_socket_test_setup (&test, FALSE, 0);
+  gstd_socket_test_frame (&test);
+
+  /* Every reply is written in the format it was built in */
+  gstd_socket_test_send (test.ostream, "format cbor", TRUE);
+  gstd_socket_test_expect_cbor (test.istream);
+
+  gstd_socket_test_send (test.ostream, "format compact", TRUE);
+  gstd_socket_test_expect_compact (test.istream);
+
+  gstd_socket_test_send (test.ostream, "format cbor", TRUE);
+  gstd_socket_test_expect_cbor (test.istream);
+
+  gstd_socket_test_send (test.ostream, "list_pipelines", TRUE);
+  gstd_socket_test_expect_cbor (test.istream);
+
+  gstd_socket_test_teardown (&test);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_tagged_out_of_order)
+{
+  GstdSocketTest test;
+
+  gstd_socket_test_setup (&test, FALSE, 0);
+  gstd_socket_test_frame (&test);
+
+  /* The bus read is parked for a second on the idle pipeline */
+  gstd_socket_test_send (test.ostream, "bus_timeout p0 1000000000", TRUE);
+  gstd_socket_test_expect_compact (test.istream);
+
+  gstd_socket_test_send (test.ostream, "#1 bus_read p0", TRUE);
+  gstd_socket_test_send (test.ostream, "#2 list_pipelines", TRUE);
+
+  /* Tagged requests are answered as they complete */
+  fail_unless_equals_int (2, gstd_socket_test_receive_id (test.istream));
+  fail_unless_equals_int (1, gstd_socket_test_receive_id (test.istream));
+
+  gstd_socket_test_teardown (&test);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_inflight_limit)
+{
+  GstdSocketTest test;
+  gboolean answered[GSTD_SOCKET_MAX_INFLIGHT + 2] = { FALSE, };
+  gchar *message;
+  guint first = 0;
+  guint id;
+  guint i;
+
+  gstd_socket_test_setup (&test, FALSE, 0);
+  gstd_socket_test_frame (&test);
+
+  gstd_socket_test_send (test.ostream, "bus_timeout p0 200000000", TRUE);
+  gstd_socket_test_expect_compact (test.istream);
+
+  /* Fill every slot with a parked bus read */
+  for (i = 1; i <= GSTD_SOCKET_MAX_INFLIGHT; i++) {
+    message = g_strdup_printf ("#%u bus_read p0", i);
+    gstd_socket_test_send (test.ostream, message, TRUE);
+    g_free (message);
+  }
+
+  /* Beyond the limit requests wait for a slot instead of running */
+  message = g_strdup_printf ("#%u list_pipelines",
+      GSTD_SOCKET_MAX_INFLIGHT + 1);
+  gstd_socket_test_send (test.ostream, message, TRUE);
+  g_free (message);
+
+  for (i = 0; i <= GSTD_SOCKET_MAX_INFLIGHT; i++) {
+    id = gstd_socket_test_receive_id (test.istream);
+    if (0 == i) {
+      first = id;
+    }
+
+    fail_unless (id >= 1 && id <= GSTD_SOCKET_MAX_INFLIGHT + 1);
+    fail_if (answered[id]);
+    answered[id] = TRUE;
+  }
+
+  /* It only ran once a bus read gave its slot back */
+  fail_if (GSTD_SOCKET_MAX_INFLIGHT + 1 == first);
+
+  gstd_socket_test_teardown (&test);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_oversized_frame)
+{
+  GstdSocketTest test;
+  guint8 header[GSTD_SOCKET_FRAME_HEADER_SIZE];
+  GBytes *reply;
+  gsize length;
+  const gchar *data;
+  gchar *code;
+  gchar c;
+
+  gstd_socket_test_setup (&test, FALSE, 0);
+  gstd_socket_test_frame (&test);
+
+  /* The header alone gives the frame away */
+  GST_WRITE_UINT32_BE (header, GSTD_SOCKET_MAX_FRAME_SIZE + 1);
+  fail_unless (g_output_stream_write_all (test.ostream, header,
+          sizeof (header), NULL, NULL, NULL));
+
+  reply = gstd_socket_test_receive (test.istream);
+  data = g_bytes_get_data (reply, &length);
+  code = g_strdup_printf ("\"code\":%d,", GSTD_BAD_COMMAND);
+  fail_unless (g_strstr_len (data, length, code));
+  g_free (code);
+  g_bytes_unref (reply);
+
+  /* And the connection is closed right after */
+  fail_unless (0 == g_input_stream_read (test.istream, &c, 1, NULL, NULL));
+
+  gstd_socket_test_teardown (&test);
+}
+GST_END_TEST;
+
+GST_START_TEST (test_idle_timeout)
+{
+  GstdSocketTest test;
+  gchar *reply;
+  gint64 start;
+  gint i;
+
+  gstd_socket_test_setup (&test, TRUE, 1);
+
+  /* A persistent connection keeps serving commands */
+  for (i = 0; i < 2; i++) {
+    gstd_socket_test_send (test.ostream, "list_pipelines", FALSE);
+    reply = gstd_socket_test_receive_text (test.istream);
+    fail_unless (reply);
+    fail_unless (strstr (reply, "\"code\" : 0"));
+    g_free (reply);
+  }
+
+  /* Until it goes quiet for longer than the idle timeout */
+  start = g_get_monotonic_time ();
+  fail_if (gstd_socket_test_receive_text (test.istream));
+  fail_unless (g_get_monotonic_time () - start >= G_USEC_PER_SEC / 2);
+
+  gstd_socket_test_teardown (&test);
+}
+GST_END_TEST;
+
+static Suite *
+gstd_socket_suite (void)
+{
+  Suite *suite = suite_create ("gstd_socket");
+  TCase *tc = tcase_create ("general");
+
+  suite_add_tcase (suite, tc);
+  tcase_add_test (tc, test_format_switch);
+  tcase_add_test (tc, test_tagged_out_of_order);
+  tcase_add_test (tc, test_inflight_limit);
+  tcase_add_test (tc, test_oversized_frame);
+  tcase_add_test (tc, test_idle_timeout);
+
+  return suite;
+}
+
+GST_CHECK_MAIN (gstd_socket);